@@ -16,13 +16,22 @@ layout (location = 0) in vec2 inPosition;
 layout(location = 1) in vec2 inTexCoord;
 
 uniform mat4 uWorldTransform;
-uniform mat4 uOrthoProj;
 uniform vec3 uColor;
 uniform vec2 uCameraPos;
 
 // (u0, v0, u1, v1) for current sprite frame
 uniform vec4 uTexRect;
 
+// Shared by every shader, only uOrthoProj is used here
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
+
 // Any vertex outputs (other than position)
 out vec2 fragTexCoord;
 
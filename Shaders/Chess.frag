@@ -3,9 +3,14 @@ out vec4 FragColor;
 
 in vec3 vWorldPos;
 
-uniform mat4 uProj;
-uniform mat4 uView;
-uniform vec2 uMousePos;
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
 
 const float GridSize = 32.0;
 
@@ -20,8 +25,7 @@ void main()
     vec3 colorB = vec3(0.7, 0.7, 0.7);
     vec3 colorS = vec3(1.0, 0.0, 0.0);
 
-    vec4 mouseWorldPos = inverse(uProj * uView) * vec4(uMousePos, 0.0, 1.0);
-    if (ceil(mouseWorldPos.xy / GridSize) == ceil(vWorldPos.xy / GridSize))
+    if (ceil(uMouseWorld / GridSize) == ceil(vWorldPos.xy / GridSize))
     {
         FragColor = vec4(colorS, 1.0);
     } else {
@@ -1,8 +1,14 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 
-uniform mat4 uProj;
-uniform mat4 uView;
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
 uniform mat4 uModel;
 
 out vec3 vWorldPos;
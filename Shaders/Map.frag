@@ -1,26 +1,50 @@
 #version 330 core
 
-uniform sampler2D uTexture;
-uniform int uTileIndex;
+// One layer per tile sprite
+uniform sampler2DArray uTiles;
+uniform int uCapitalLayer;
+// Tile under the mouse, picked on the CPU
+uniform vec2 uHoveredTile;
 
-uniform mat4 uProj;
-uniform mat4 uView;
-uniform vec2 uMousePos;
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
 
 in vec2 vTexCoord;
-in vec3 vWorldPos;
+flat in vec2 vTilePos;
+flat in uvec3 vTile;
 
 out vec4 FragColor;
 
-const float GridSize = 32.0;
+const uint NoTile = 255u;
+const uint CapitalFlag = 1u;
+
+vec4 SampleTile(uint layer)
+{
+    return texture(uTiles, vec3(vTexCoord, float(layer)));
+}
+
+// Same result as drawing the tile over the color with alpha blending
+vec3 Blend(vec3 color, uint layer)
+{
+    vec4 tile = SampleTile(layer);
+    return mix(color, tile.rgb, tile.a);
+}
 
 void main()
 {
-    vec2 texCoord = (vec2(32.0f, 0.0f) * uTileIndex + vTexCoord * 32.0f) / (vec2(12.0f, 1.0f) * 32.0f);
-    FragColor = texture(uTexture, texCoord);
+    FragColor = SampleTile(vTile.x);
+    if (vTile.y != NoTile)
+        FragColor.rgb = Blend(FragColor.rgb, vTile.y);
+    if ((vTile.z & CapitalFlag) != 0u)
+        FragColor.rgb = Blend(FragColor.rgb, uint(uCapitalLayer));
 
-    vec4 mouseWorldPos = inverse(uProj * uView) * vec4(uMousePos, 0.0, 1.0);
-    if (round(mouseWorldPos.xy / GridSize) == round(vWorldPos.xy / GridSize))
+    if (vTilePos == uHoveredTile)
     {
         FragColor *= vec4(1.0f, 0.1f, 0.1f, 1.0f);
     }
@@ -1,21 +1,33 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+// Per instance: tile position, then base tile, overlay tile and flags
+layout (location = 2) in vec2 aTilePos;
+layout (location = 3) in uvec4 aTile;
 
-uniform mat4 uProj;
-uniform mat4 uView;
-uniform mat4 uModel;
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
 
-out vec3 vWorldPos;
 out vec2 vTexCoord;
+flat out vec2 vTilePos;
+flat out uvec3 vTile;
+
+const float GridSize = 32.0;
 
 void main()
 {
     vTexCoord = aTexCoord;
+    vTile = aTile.xyz;
+    vTilePos = aTilePos;
 
-    vec4 world = uModel * vec4(aPos, 0.0, 1.0);
-    vWorldPos = world.xyz;
+    vec4 world = vec4((aTilePos + aPos) * GridSize, 0.0, 1.0);
 
     gl_Position = uProj * uView * world;
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,20 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec4 aColor;
+
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
+
+out vec4 vColor;
+
+void main()
+{
+    vColor = aColor;
+    gl_Position = uProj * uView * vec4(aPos, 0.0, 1.0);
+}
@@ -0,0 +1,49 @@
+#version 330 core
+
+// Per tile: palette slot of the topmost realm, culture, army and flags
+uniform usampler2D uProvinceData;
+// Per realm slot: color and relation with the player, negative if the realm no longer exists
+uniform sampler2D uRealmPalette;
+// MapMode of DrawProvinces.hpp
+uniform int uMapMode;
+
+in vec2 vTilePos;
+
+out vec4 FragColor;
+
+const int Political = 1;
+const int Cultural = 2;
+const int Diplomatic = 3;
+const int Army = 4;
+
+const uint NoRealm = 65535u;
+
+// Indexed by CultureType
+const vec3 CultureColors[4] = vec3[4](
+    vec3(0.7, 0.6, 0.4),
+    vec3(0.4, 0.8, 0.3),
+    vec3(0.1, 0.4, 0.15),
+    vec3(0.5, 0.5, 0.55)
+);
+
+void main()
+{
+    uvec4 data = texelFetch(uProvinceData, ivec2(floor(vTilePos + 0.5)), 0);
+    if (data.r == NoRealm)
+        discard;
+
+    vec4 realm = texelFetch(uRealmPalette, ivec2(int(data.r), 0), 0);
+    if (realm.a < 0.0)
+        discard;
+
+    if (uMapMode == Political)
+        FragColor = vec4(realm.rgb, 1.0);
+    else if (uMapMode == Cultural)
+        FragColor = vec4(CultureColors[min(data.g, 3u)], 1.0);
+    else if (uMapMode == Diplomatic)
+        FragColor = mix(vec4(1.0, 0.0, 0.0, 1.0), vec4(0.0, 1.0, 0.0, 1.0), realm.a);
+    else if (uMapMode == Army)
+        FragColor = mix(vec4(0.0, 0.0, 0.0, 1.0), vec4(1.0, 0.0, 0.0, 1.0), clamp(float(data.b) / 100.0, 0.0, 1.0));
+    else
+        discard;
+}
@@ -0,0 +1,27 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
+// Visible tiles as (first x, first y, last x, last y)
+uniform vec4 uTileRect;
+
+// Position in tiles, tile (x, y) is centered at (x, y)
+out vec2 vTilePos;
+
+const float GridSize = 32.0;
+
+void main()
+{
+    // The unit quad is stretched over the visible tiles
+    vTilePos = uTileRect.xy - 0.5 + (aPos + 0.5) * (uTileRect.zw - uTileRect.xy + 1.0);
+
+    gl_Position = uProj * uView * vec4(vTilePos * GridSize, 0.0, 1.0);
+}
@@ -0,0 +1,15 @@
+#version 330 core
+
+uniform sampler2D uTexture;
+
+in vec2 vTexCoord;
+// Color, then the texture factor in w
+in vec4 vColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec4 texel = texture(uTexture, vTexCoord);
+    FragColor = vec4(mix(vColor.rgb, texel.rgb, vColor.w), mix(1.0, texel.a, vColor.w));
+}
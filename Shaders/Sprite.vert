@@ -0,0 +1,32 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+// Per instance: screen position and size, color and texture factor, texture rect and rotation
+layout (location = 2) in vec4 aPositionSize;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in vec4 aTexRect;
+layout (location = 5) in float aRotation;
+
+// Shared by every shader, only uOrthoProj is used here
+layout (std140) uniform Camera
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uOrthoProj;
+    vec2 uMousePos;
+    vec2 uMouseWorld;
+};
+
+out vec2 vTexCoord;
+out vec4 vColor;
+
+void main()
+{
+    vec2 local = aPos * aPositionSize.zw;
+    float c = cos(aRotation), s = sin(aRotation);
+    vec2 position = vec2(c * local.x - s * local.y, s * local.x + c * local.y) + aPositionSize.xy;
+
+    gl_Position = uOrthoProj * vec4(position, 0.0, 1.0);
+    vTexCoord = aTexRect.xy + aTexRect.zw * aTexCoord;
+    vColor = aColor;
+}
@@ -1,6 +1,7 @@
 #include "Camera.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <SDL3/SDL.h>
 #include "imgui.h"
 #include "Window.hpp"
@@ -43,6 +44,20 @@ glm::vec3 Camera::NDCToWorld(const glm::vec2& NDC, const Window& window) const
     return VPI * glm::vec4(NDC, 0.0f, 1.0f);
 }
 
+glm::vec4 Camera::GetVisibleRect(const Window& window) const
+{
+    const glm::mat4 VPI = glm::inverse(CalculateProjection(window) * mView);
+    glm::vec2 min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest());
+    const glm::vec2 corners[] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+    for (const auto &corner : corners)
+    {
+        const glm::vec2 world(VPI * glm::vec4(corner, 0.0f, 1.0f));
+        min = glm::min(min, world);
+        max = glm::max(max, world);
+    }
+    return {min, max};
+}
+
 void UpdateCamera(Camera &camera, const InputState &input, const Window &window, float deltaTime)
 {
     const bool* state = SDL_GetKeyboardState(nullptr);
@@ -27,6 +27,8 @@ struct Camera
     float GetProjectionScale() const;
     glm::mat4 CalculateProjection(const Window &window) const;
     glm::vec3 NDCToWorld(const glm::vec2& NDC, const Window& window) const;
+    // World space rect seen by the camera as (min x, min y, max x, max y)
+    glm::vec4 GetVisibleRect(const Window& window) const;
 };
 
 void UpdateCamera(Camera &camera, const struct InputState &input, const Window &window, float deltaTime);
@@ -22,10 +22,12 @@
 #include "Systems/GameBoard.hpp"
 #include "Systems/Events.hpp"
 #include "Systems/Characters.hpp"
+#include "Systems/DecisionPolicy.hpp"
 #include "Systems/Diplomacy.hpp"
 #include "Systems/Sound.hpp"
 #include "Systems/MapGenerator.hpp"
 #include "Systems/ProvinceUpdate.hpp"
+#include "Systems/Queries.hpp"
 #include "UI/GameOver.hpp"
 
 bool Initialize(flecs::world &ecs) {
@@ -82,6 +84,35 @@ bool Initialize(flecs::world &ecs) {
     return true;
 }
 
+bool InitializeHeadless(flecs::world &ecs) {
+    Random::Init();
+
+    void(ecs.component<Headless>().add(flecs::Singleton));
+    ecs.add<Headless>();
+
+    void(ecs.component<DecisionPolicy>()
+        .add(flecs::Singleton)
+        .emplace<DecisionPolicy>(DecisionPolicy::FirstChoice()));
+
+    void(ecs.component<GameTickSources>()
+        .add(flecs::Singleton)
+        .emplace<GameTickSources>(ecs));
+
+    ImportSimulationModules(ecs);
+
+    return true;
+}
+
+void CreateGameWorld(const flecs::world &ecs, uint32_t mapSeed, int mapWidth, int mapHeight) {
+    const auto oldScope = ecs.set_scope(ecs.entity("Kingdoms"));
+    void(ecs.entity<Player>().add<Player>());
+    void(ecs.add<GameTime>());
+    void(ecs.add<EstatePowers>());
+    GenerateMap(ecs, mapSeed, mapWidth, mapHeight);
+    CreateKingdoms(ecs);
+    void(ecs.set_scope(oldScope));
+}
+
 void RegisterSystems(flecs::world &ecs) {
     void(ecs.component<GameStarted>().add(flecs::Singleton));
     void(ecs.entity<GameEnded>().add(flecs::Singleton));
@@ -98,10 +129,6 @@ void RegisterSystems(flecs::world &ecs) {
         {
             ecs.defer_suspend();
 
-            const auto oldScope = ecs.set_scope(ecs.entity("Kingdoms"));
-            void(ecs.entity<Player>().add<Player>());
-            void(ecs.add<GameTime>());
-            void(ecs.add<EstatePowers>());
             void(ecs.add<Camera>());
             void(ecs.entity().child_of(ecs.entity("Events"))
                 .set<SamplePopup>({
@@ -110,9 +137,7 @@ void RegisterSystems(flecs::world &ecs) {
                         "Além disso, deve cuidar da diplomacia de seu reino, e pode mover exércitos pelo mapa para conquistar novos territórios.\n"
                         "A cada ano, recebe uma renda de suas provincias. Boa sorte!" })
                 .add<FiredEvent>());
-            GenerateMap(ecs, 36533);
-            CreateKingdoms(ecs);
-            void(ecs.set_scope(oldScope));
+            CreateGameWorld(ecs, 36533, DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT);
 
             auto &camera = ecs.get_mut<Camera>();
 
@@ -178,15 +203,32 @@ void RegisterSystems(flecs::world &ecs) {
             renderer.Clear();
         });
 
+    // Camera state is uploaded once per frame, before any map draw
+    ecs.system<Renderer, const Camera, const Window>("UploadCameraBlock")
+        .kind(flecs::PreStore)
+        .each([](Renderer &renderer, const Camera &camera, const Window &window) {
+            const auto &mousePos = window.GetMousePosNDC();
+            renderer.UpdateCameraBlock(camera.mView, camera.CalculateProjection(window), mousePos,
+                                       glm::vec2(camera.NDCToWorld(mousePos, window)));
+        });
+
     ecs.system<Renderer>("PresentRender")
         .kind(flecs::OnStore)
         .each([](Renderer &renderer) {
+            renderer.FlushPrimitives();
             ImGui::Render();
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
             renderer.Present();
         });
 }
 
+// Builds the shared queries, after CharactersModule has set the traits of the relations they use
+static void RegisterQueries(const flecs::world& ecs) {
+    void(ecs.component<QueryRegistry>()
+        .add(flecs::Singleton)
+        .emplace<QueryRegistry>(ecs));
+}
+
 void ImportModules(flecs::world& ecs) {
     // UI Modules
     void(ecs.import<MainMenuModule>());
@@ -199,6 +241,7 @@ void ImportModules(flecs::world& ecs) {
     // Game Systems
     void(ecs.import<SoundModule>().disable());
     void(ecs.import<CharactersModule>().child_of(gameUI));
+    RegisterQueries(ecs);
     void(ecs.import<GameBoardScene>().child_of(gameUI));
     void(ecs.import<EventsModule>().child_of(gameUI));
     void(ecs.import<DiplomacyModule>().child_of(gameUI));
@@ -206,6 +249,15 @@ void ImportModules(flecs::world& ecs) {
     void(ecs.import<ArmyModule>().child_of(gameUI));
 }
 
+void ImportSimulationModules(flecs::world& ecs) {
+    // Only systems which don't need a window, renderer or ImGui
+    void(ecs.import<CharactersModule>());
+    RegisterQueries(ecs);
+    void(ecs.import<EventsModule>());
+    void(ecs.import<DiplomacyModule>());
+    void(ecs.import<ProvinceUpdates>());
+}
+
 GameTickSources::GameTickSources(const flecs::world& ecs) {
     mTickTimer = ecs.timer("TickTimer");
     mDayTimer = ecs.timer("DayTimer");
@@ -3,9 +3,14 @@
 #include <glm/glm.hpp>
 
 bool Initialize(flecs::world &ecs);
+// Sets up only the simulation, without window, renderer or ImGui
+bool InitializeHeadless(flecs::world &ecs);
 void ProcessInput(const flecs::world &ecs);
 void RegisterSystems(flecs::world &ecs);
 void ImportModules(flecs::world &ecs);
+void ImportSimulationModules(flecs::world &ecs);
+// Creates the player, the map and the kingdoms of a new game
+void CreateGameWorld(const flecs::world &ecs, uint32_t mapSeed, int mapWidth, int mapHeight);
 
 struct InputState
 {
@@ -34,3 +39,5 @@ struct GameTickSources
 
 struct GameStarted {};
 struct GameEnded {};
+// Present when running without window/UI, choices are made by the DecisionPolicy
+struct Headless {};
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Contiguous 2D buffer in row-major order, the same layout as the TileMap columns.
+// Resizing to the same or a smaller size keeps the allocation.
+template <typename T>
+class Grid2D
+{
+public:
+    Grid2D() = default;
+    Grid2D(int width, int height, const T &value = T())
+    {
+        Resize(width, height, value);
+    }
+
+    void Resize(int width, int height, const T &value = T())
+    {
+        mWidth = width;
+        mHeight = height;
+        mData.assign(static_cast<size_t>(width) * height, value);
+    }
+
+    [[nodiscard]] int Width() const { return mWidth; }
+    [[nodiscard]] int Height() const { return mHeight; }
+    [[nodiscard]] size_t Size() const { return mData.size(); }
+    // Bytes reserved by the buffer, which may be more than Size() after shrinking
+    [[nodiscard]] size_t CapacityBytes() const { return mData.capacity() * sizeof(T); }
+
+    [[nodiscard]] bool Contains(int x, int y) const
+    {
+        return x >= 0 && x < mWidth && y >= 0 && y < mHeight;
+    }
+    [[nodiscard]] size_t Index(int x, int y) const
+    {
+        return static_cast<size_t>(y) * mWidth + x;
+    }
+
+    T &operator()(int x, int y) { return mData[Index(x, y)]; }
+    const T &operator()(int x, int y) const { return mData[Index(x, y)]; }
+
+    T *Row(int y) { return mData.data() + Index(0, y); }
+    const T *Row(int y) const { return mData.data() + Index(0, y); }
+
+    T *Data() { return mData.data(); }
+    const T *Data() const { return mData.data(); }
+
+private:
+    int mWidth = 0;
+    int mHeight = 0;
+    std::vector<T> mData;
+};
@@ -0,0 +1,169 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Distance of a node no path reached, and the step cost that blocks a move
+constexpr uint32_t NO_PATH = std::numeric_limits<uint32_t>::max();
+
+// Monotone priority queue of (distance, node) pairs with integer distances (Dial's algorithm).
+// One bucket per distance in a ring covering the largest step pushed so far, so Push and Pop are
+// O(1) apart from sorting the bucket being drained. Pairs come out in ascending (distance, node)
+// order, the same order as HeapQueue.
+class BucketQueue
+{
+public:
+    void Clear()
+    {
+        for (auto &bucket : mBuckets) bucket.clear();
+        mCurrent = 0;
+        mSize = 0;
+        mSorted = false;
+    }
+
+    [[nodiscard]] bool Empty() const { return mSize == 0; }
+
+    // distance can't be lower than the last popped one, the ring spans from there to the largest distance queued
+    void Push(uint32_t distance, uint32_t node)
+    {
+        const size_t span = static_cast<size_t>(distance - mCurrent) + 1;
+        if (span > mBuckets.size()) Grow(span);
+
+        mBuckets[distance & mMask].push_back(node);
+        if (distance == mCurrent) mSorted = false;
+        ++mSize;
+    }
+
+    bool Pop(uint32_t &distance, uint32_t &node)
+    {
+        if (mSize == 0) return false;
+
+        auto *bucket = &mBuckets[mCurrent & mMask];
+        while (bucket->empty())
+        {
+            bucket = &mBuckets[++mCurrent & mMask];
+            mSorted = false;
+        }
+        // Descending, so the lowest node is popped from the back
+        if (!mSorted)
+        {
+            std::sort(bucket->begin(), bucket->end(), std::greater<>());
+            mSorted = true;
+        }
+
+        distance = mCurrent;
+        node = bucket->back();
+        bucket->pop_back();
+        --mSize;
+        return true;
+    }
+
+    [[nodiscard]] size_t CapacityBytes() const
+    {
+        size_t bytes = mBuckets.capacity() * sizeof(mBuckets[0]);
+        for (const auto &bucket : mBuckets) bytes += bucket.capacity() * sizeof(uint32_t);
+        return bytes;
+    }
+
+private:
+    // Widens the ring to a power of two holding span distances, moving every queued node to its new bucket
+    void Grow(size_t span)
+    {
+        std::vector<std::vector<uint32_t>> old = std::move(mBuckets);
+        const size_t oldCount = old.size();
+
+        mBuckets.assign(std::max<size_t>(std::bit_ceil(span), 16), {});
+        mMask = static_cast<uint32_t>(mBuckets.size() - 1);
+
+        for (size_t i = 0; i < oldCount; ++i)
+        {
+            // The distance held by an old bucket is the one in [mCurrent, mCurrent + oldCount) landing on it
+            const uint32_t distance = mCurrent + static_cast<uint32_t>((i + oldCount - mCurrent % oldCount) % oldCount);
+            auto &bucket = mBuckets[distance & mMask];
+            bucket.insert(bucket.end(), old[i].begin(), old[i].end());
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> mBuckets;
+    uint32_t mMask = 0;
+    uint32_t mCurrent = 0;
+    size_t mSize = 0;
+    bool mSorted = false;
+};
+
+// Binary heap with the interface of BucketQueue, the reference it is benchmarked against
+class HeapQueue
+{
+public:
+    void Clear() { mHeap.clear(); }
+    [[nodiscard]] bool Empty() const { return mHeap.empty(); }
+
+    void Push(uint32_t distance, uint32_t node)
+    {
+        mHeap.emplace_back(distance, node);
+        std::push_heap(mHeap.begin(), mHeap.end(), std::greater<>());
+    }
+
+    bool Pop(uint32_t &distance, uint32_t &node)
+    {
+        if (mHeap.empty()) return false;
+        std::pop_heap(mHeap.begin(), mHeap.end(), std::greater<>());
+        std::tie(distance, node) = mHeap.back();
+        mHeap.pop_back();
+        return true;
+    }
+
+    [[nodiscard]] size_t CapacityBytes() const { return mHeap.capacity() * sizeof(mHeap[0]); }
+
+private:
+    std::vector<std::pair<uint32_t, uint32_t>> mHeap;
+};
+
+// Dijkstra over a 4-connected width x height grid of row-major nodes, starting from the nodes already
+// pushed on queue with their distance set. step(from, to) is the cost of moving between neighbours,
+// NO_PATH to block the move. relaxed(from, to) runs after a shorter path lowered distance[to].
+// Paths longer than limit are not followed.
+template <typename Queue, typename Step, typename Relaxed>
+void ExpandGrid(Queue &queue, int width, int height, uint32_t *distance, Step &&step, Relaxed &&relaxed,
+                uint32_t limit = NO_PATH - 1)
+{
+    uint32_t current, node;
+    while (queue.Pop(current, node))
+    {
+        // A shorter path to this node was already expanded
+        if (current > distance[node]) continue;
+
+        const int x = static_cast<int>(node % static_cast<uint32_t>(width));
+        const int y = static_cast<int>(node / static_cast<uint32_t>(width));
+        const std::pair<int, int> neighbours[] = {{x, y + 1}, {x, y - 1}, {x + 1, y}, {x - 1, y}};
+        for (const auto &[nx, ny] : neighbours)
+        {
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            const uint32_t next = static_cast<uint32_t>(ny) * static_cast<uint32_t>(width) + static_cast<uint32_t>(nx);
+            const uint32_t cost = step(node, next);
+            if (cost == NO_PATH || cost > limit - current) continue;
+
+            const uint32_t newDistance = current + cost;
+            if (newDistance < distance[next])
+            {
+                distance[next] = newDistance;
+                relaxed(node, next);
+                queue.Push(newDistance, next);
+            }
+        }
+    }
+}
+
+// Movement costs are whole numbers stored as floats, negative ones are free moves and infinite ones block
+inline uint32_t StepCost(float cost)
+{
+    if (std::isinf(cost)) return NO_PATH;
+    return cost > 0.0f ? static_cast<uint32_t>(cost) : 0;
+}
@@ -0,0 +1,479 @@
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <SDL3/SDL.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Game.hpp"
+#include "GridPaths.hpp"
+#include "Parallel.hpp"
+#include "Random.hpp"
+#include "Systems/DecisionPolicy.hpp"
+#include "Systems/GameTime.hpp"
+#include "Systems/MapGenerator.hpp"
+#include "Systems/PerlinNoise.hpp"
+#include "Systems/ProvinceUpdate.hpp"
+
+struct HeadlessOptions
+{
+    uint64_t mDays = 360 * 100;
+    uint32_t mMapSeed = 36533;
+    uint32_t mSeed = 0;
+    uint32_t mTicksPerDay = 0;
+    int mMapWidth = DEFAULT_MAP_WIDTH;
+    int mMapHeight = DEFAULT_MAP_HEIGHT;
+    // Largest map width of the map size benchmark, 0 to run a normal simulation
+    int mBenchMapWidth = 0;
+    uint64_t mBenchDays = 30;
+    // Sample points of the noise kernel benchmark, 0 to skip it
+    size_t mBenchNoisePoints = 0;
+    // Largest map width of the shortest path benchmark, 0 to skip it
+    int mBenchPathsWidth = 0;
+    bool mHasSeed = false;
+    bool mRandomPolicy = false;
+    bool mHelp = false;
+    int mThreads = static_cast<int>(std::thread::hardware_concurrency());
+};
+
+static void PrintUsage(const char *program)
+{
+    SDL_Log("Usage: %s [--years N] [--days N] [--seed N] [--map-seed N] [--policy first|random] [--threads N] [--ticks-per-day N]"
+            " [--map-width N] [--map-height N] [--bench-map MAX_WIDTH] [--bench-days N]"
+            " [--bench-noise POINTS] [--bench-paths MAX_WIDTH]", program);
+}
+
+// Parses the value of arg as a whole number in [min, max of T], logging why it is not one
+template <typename T>
+static bool ParseNumber(const char *arg, const char *value, T &out, T min = 0)
+{
+    if (value == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s expects a value", arg);
+        return false;
+    }
+
+    errno = 0;
+    char *end = nullptr;
+    const unsigned long long parsed = strtoull(value, &end, 10);
+    const bool number = value[0] >= '0' && value[0] <= '9' && *end == '\0' && errno == 0;
+    if (!number || parsed < static_cast<unsigned long long>(min) ||
+        parsed > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s expects a number from %llu to %llu, got %s", arg,
+                     static_cast<unsigned long long>(min),
+                     static_cast<unsigned long long>(std::numeric_limits<T>::max()), value);
+        return false;
+    }
+    out = static_cast<T>(parsed);
+    return true;
+}
+
+// Returns false on an invalid argument, after logging it
+static bool ParseOptions(int argc, char* argv[], HeadlessOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--help") == 0)
+        {
+            options.mHelp = true;
+            return true;
+        }
+
+        bool valid;
+        if (strcmp(arg, "--years") == 0)
+        {
+            uint64_t years = 0;
+            valid = ParseNumber(arg, value, years);
+            if (valid && years > std::numeric_limits<uint64_t>::max() / 360)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "--years is too large, got %s", value);
+                valid = false;
+            }
+            options.mDays = years * 360;
+        }
+        else if (strcmp(arg, "--days") == 0) valid = ParseNumber(arg, value, options.mDays);
+        else if (strcmp(arg, "--map-seed") == 0) valid = ParseNumber(arg, value, options.mMapSeed);
+        else if (strcmp(arg, "--threads") == 0) valid = ParseNumber(arg, value, options.mThreads, 1);
+        else if (strcmp(arg, "--ticks-per-day") == 0)
+        {
+            valid = ParseNumber(arg, value, options.mTicksPerDay, 1u);
+            if (valid && DAY_DURATION % options.mTicksPerDay != 0)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "--ticks-per-day must divide %" PRIu64 ", got %s", DAY_DURATION, value);
+                valid = false;
+            }
+        }
+        else if (strcmp(arg, "--map-width") == 0) valid = ParseNumber(arg, value, options.mMapWidth, 2);
+        else if (strcmp(arg, "--map-height") == 0) valid = ParseNumber(arg, value, options.mMapHeight, 2);
+        else if (strcmp(arg, "--bench-map") == 0) valid = ParseNumber(arg, value, options.mBenchMapWidth);
+        else if (strcmp(arg, "--bench-days") == 0) valid = ParseNumber(arg, value, options.mBenchDays);
+        else if (strcmp(arg, "--bench-noise") == 0) valid = ParseNumber(arg, value, options.mBenchNoisePoints);
+        else if (strcmp(arg, "--bench-paths") == 0) valid = ParseNumber(arg, value, options.mBenchPathsWidth);
+        else if (strcmp(arg, "--policy") == 0)
+        {
+            valid = value != nullptr && (strcmp(value, "first") == 0 || strcmp(value, "random") == 0);
+            if (valid) options.mRandomPolicy = strcmp(value, "random") == 0;
+            else SDL_LogError(SDL_LOG_CATEGORY_ERROR, "--policy expects first or random, got %s", value ? value : "nothing");
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            valid = ParseNumber(arg, value, options.mSeed);
+            options.mHasSeed = true;
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unknown option %s", arg);
+            valid = false;
+        }
+
+        if (!valid) return false;
+        ++i;
+    }
+    return true;
+}
+
+static bool SetupSimulation(flecs::world &ecs, const HeadlessOptions &options, int mapWidth, int mapHeight)
+{
+    if (InitializeHeadless(ecs) == false) return false;
+
+    // The flecs workers and the ParallelFor pool are both sized by --threads, see main
+    if (GetParallelThreadCount() > 1) ecs.set_threads(static_cast<int>(GetParallelThreadCount()));
+    if (options.mHasSeed) Random::Seed(options.mSeed);
+    if (options.mRandomPolicy) ecs.set<DecisionPolicy>(DecisionPolicy::RandomChoice());
+    if (options.mTicksPerDay != 0)
+        ecs.get_mut<SimulationClock>().mTicksPerDay = options.mTicksPerDay;
+
+    CreateGameWorld(ecs, options.mMapSeed, mapWidth, mapHeight);
+
+    flecs::timer tickTimer = ecs.get<GameTickSources>().mTickTimer;
+    tickTimer.start();
+
+    // The steps are driven by RunDays instead of by real time, so the speed is only bound by the CPU
+    ecs.get_mut<GameTime>().mSpeed = 0.0f;
+    return true;
+}
+
+// Simulates until the given day or until the game ends, returns the last simulated day
+static uint64_t RunDays(const flecs::world &ecs, uint64_t days)
+{
+    const uint32_t ticksPerDay = ecs.get<SimulationClock>().mTicksPerDay;
+
+    // One simulated day per frame, the frame resolves the events fired during the day
+    while (ecs.get<GameTime>().TimeDays() < days)
+    {
+        for (uint32_t i = 0; i < ticksPerDay; ++i)
+            StepSimulation(ecs);
+        if (ecs.progress(1.0f) == false) break;
+    }
+    return ecs.get<GameTime>().TimeDays();
+}
+
+// Times the serial and the parallel height map generators, checking that their outputs are identical
+static bool BenchmarkHeightMap(uint32_t seed, int width, int height, double &serialMs, double &parallelMs)
+{
+    Grid2D<float> serial(width, height), parallel(width, height);
+
+    auto start = std::chrono::steady_clock::now();
+    generate_height_map(seed, serial);
+    serialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    generate_height_map_parallel(seed, parallel);
+    parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return memcmp(serial.Data(), parallel.Data(), serial.Size() * sizeof(float)) == 0;
+}
+
+// Compares the vectorised noise kernel with the scalar noise() over the octaves of a 1024x512 map
+static int RunNoiseBenchmark(const HeadlessOptions &options)
+{
+    const size_t count = options.mBenchNoisePoints;
+    const auto scales = get_noise_scales(1024, 512);
+    std::vector<float> xs(count), ys(count), legacy(count), scalar(count), vectorised(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        xs[i] = static_cast<float>(i % 1024);
+        ys[i] = static_cast<float>(i / 1024 % 512);
+    }
+
+    const PerlinNoise noise(options.mMapSeed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        float value = 0.0f;
+        for (const float scale : scales)
+            value += noise.noise_legacy(xs[i] / scale, ys[i] / scale);
+        legacy[i] = value;
+    }
+    const std::chrono::duration<double> legacyTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    noise.octaves_scalar(xs.data(), ys.data(), count, scales, scalar.data());
+    const std::chrono::duration<double> scalarTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    noise.octaves(xs.data(), ys.data(), count, scales, vectorised.data());
+    const std::chrono::duration<double> vectorisedTime = std::chrono::steady_clock::now() - start;
+
+    const bool identical = memcmp(scalar.data(), vectorised.data(), count * sizeof(float)) == 0 &&
+                           memcmp(legacy.data(), scalar.data(), count * sizeof(float)) == 0;
+    SDL_Log("%zu points, %zu octaves", count, scales.size());
+    SDL_Log("Old noise(), per-call gradient array: %.1f Mpoints/s", count / legacyTime.count() * 1e-6);
+    SDL_Log("Scalar, gradient tables: %.1f Mpoints/s (%.2fx old)", count / scalarTime.count() * 1e-6,
+            legacyTime.count() / scalarTime.count());
+    SDL_Log("%s: %.1f Mpoints/s (%.2fx old, %.2fx scalar)", PerlinNoise::kernel_name(),
+            count / vectorisedTime.count() * 1e-6, legacyTime.count() / vectorisedTime.count(),
+            scalarTime.count() / vectorisedTime.count());
+    if (identical == false)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Scalar or %s noise differs from the old noise()", PerlinNoise::kernel_name());
+        return 1;
+    }
+    return 0;
+}
+
+// Multi-source shortest paths over the land of a map with the given queue, returns the time taken
+template <typename Queue>
+static double TimeGridPaths(const Grid2D<uint32_t> &cost, const std::vector<uint32_t> &sources,
+                            Queue &queue, std::vector<uint32_t> &distance)
+{
+    const auto start = std::chrono::steady_clock::now();
+    distance.assign(cost.Size(), NO_PATH);
+    queue.Clear();
+    for (const uint32_t source : sources)
+    {
+        distance[source] = 0;
+        queue.Push(0, source);
+    }
+    ExpandGrid(queue, cost.Width(), cost.Height(), distance.data(),
+               [&](uint32_t, uint32_t to) { return cost.Data()[to]; },
+               [](uint32_t, uint32_t) {});
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Splits the land of a map in square realms, the first land tile of each one is its capital.
+// Every third capital is handed to the next realm, as if it had been conquered.
+static void MakeBenchRealms(const MapGenArena &arena, TileMap &tileMap,
+                            std::vector<std::pair<uint32_t, flecs::entity_t>> &capitals)
+{
+    constexpr int REALM_SIDE = 16;
+    const int width = arena.terrain_map.Width(), height = arena.terrain_map.Height();
+    const int realmsX = (width + REALM_SIDE - 1) / REALM_SIDE;
+
+    tileMap.Resize(width, height);
+    capitals.clear();
+    std::vector<uint8_t> hasCapital(static_cast<size_t>(realmsX) * ((height + REALM_SIDE - 1) / REALM_SIDE) + 1, 0);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+            const size_t i = tileMap.Index(x, y);
+            const TerrainType terrain = arena.terrain_map(x, y);
+            tileMap.movement_cost[i] = province_movement_cost(terrain, arena.biome_map(x, y), 0);
+            if (terrain == Sea) continue;
+
+            const flecs::entity_t realm = 1 + static_cast<flecs::entity_t>(y / REALM_SIDE * realmsX + x / REALM_SIDE);
+            tileMap.realm[i] = realm;
+            if (hasCapital[realm]) continue;
+            hasCapital[realm] = 1;
+            capitals.emplace_back(static_cast<uint32_t>(i), realm);
+        }
+
+    for (size_t i = 0; i + 1 < capitals.size(); i += 3)
+        tileMap.realm[capitals[i].first] = capitals[i + 1].second;
+}
+
+// Capital distances with one search per realm over its own tiles, the reference of CapitalDistanceField
+static double TimePerRealmDistances(const TileMap &tileMap,
+                                    const std::vector<std::pair<uint32_t, flecs::entity_t>> &capitals,
+                                    std::vector<uint32_t> &distance)
+{
+    const auto start = std::chrono::steady_clock::now();
+    distance.assign(tileMap.tiles.size(), NO_PATH);
+    std::vector<uint32_t> pass(tileMap.tiles.size(), NO_PATH);
+    std::vector<uint32_t> reached;
+    HeapQueue queue;
+    for (const auto &[capital, realm] : capitals)
+    {
+        pass[capital] = 0;
+        reached.assign(1, capital);
+        queue.Push(0, capital);
+        ExpandGrid(queue, tileMap.width, tileMap.height, pass.data(),
+                   [&](uint32_t, uint32_t to)
+                   {
+                       return tileMap.realm[to] == realm ? StepCost(tileMap.movement_cost[to]) : NO_PATH;
+                   },
+                   [&](uint32_t, uint32_t to) { reached.push_back(to); });
+
+        for (const uint32_t tile : reached)
+        {
+            if (tileMap.realm[tile] == realm) distance[tile] = std::min(distance[tile], pass[tile]);
+            pass[tile] = NO_PATH;
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compares the bucket queue with a binary heap on the movement costs of 2:1 maps of doubling width,
+// then the single pass capital distances with one search per realm, checking that each pair agrees
+static int RunPathsBenchmark(const HeadlessOptions &options)
+{
+    constexpr int SOURCES = 64;
+    SDL_Log("%10s %10s %12s %12s %10s %12s %12s %10s", "Map", "Tiles", "Heap ms", "Bucket ms", "Speedup",
+            "Realms ms", "Field ms", "Speedup");
+    for (int width = 128; width <= options.mBenchPathsWidth; width *= 2)
+    {
+        const int height = width / 2;
+
+        MapGenArena arena;
+        arena.height_map.Resize(width, height);
+        generate_height_map_parallel(options.mMapSeed, arena.height_map);
+        label_terrain(arena.height_map, arena.terrain_map);
+        keep_largest_landmass(arena.terrain_map, arena.labels, arena.queue);
+        assign_biomes(options.mMapSeed, arena.terrain_map, arena.height_map, arena.distance_map, arena.queue,
+                      arena.biome_map);
+
+        Grid2D<uint32_t> cost(width, height);
+        std::vector<uint32_t> land;
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+            {
+                const TerrainType terrain = arena.terrain_map(x, y);
+                if (terrain == Sea)
+                {
+                    cost(x, y) = NO_PATH;
+                    continue;
+                }
+                cost(x, y) = StepCost(province_movement_cost(terrain, arena.biome_map(x, y), 0));
+                land.push_back(static_cast<uint32_t>(cost.Index(x, y)));
+            }
+
+        std::vector<uint32_t> sources;
+        std::mt19937 rng(options.mMapSeed);
+        for (int i = 0; i < SOURCES && !land.empty(); ++i)
+            sources.push_back(land[rng() % land.size()]);
+
+        HeapQueue heap;
+        BucketQueue buckets;
+        std::vector<uint32_t> heapDistance, bucketDistance;
+        const double heapMs = TimeGridPaths(cost, sources, heap, heapDistance);
+        const double bucketMs = TimeGridPaths(cost, sources, buckets, bucketDistance);
+        if (heapDistance != bucketDistance)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Bucket queue distances differ from the heap ones at %dx%d", width, height);
+            return 1;
+        }
+
+        TileMap tileMap;
+        CapitalDistanceField field;
+        MakeBenchRealms(arena, tileMap, field.capitals);
+        std::vector<uint32_t> realmDistance;
+        const double realmsMs = TimePerRealmDistances(tileMap, field.capitals, realmDistance);
+        const auto start = std::chrono::steady_clock::now();
+        field.Solve(tileMap);
+        const double fieldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (field.distance != realmDistance)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Capital distances differ from the per-realm ones at %dx%d", width, height);
+            return 1;
+        }
+
+        const std::string size = std::to_string(width) + "x" + std::to_string(height);
+        SDL_Log("%10s %10d %12.2f %12.2f %9.2fx %12.2f %12.2f %9.2fx", size.c_str(), width * height, heapMs, bucketMs,
+                heapMs / bucketMs, realmsMs, fieldMs, realmsMs / fieldMs);
+    }
+    return 0;
+}
+
+// Generates 2:1 maps of doubling width, reporting the generation time and the cost of a simulated day
+static int RunMapBenchmark(const HeadlessOptions &options)
+{
+    SDL_Log("%10s %10s %14s %14s %14s %12s %12s %14s %14s", "Map", "Tiles", "Height ms", "Parallel ms",
+            "Generation ms", "Spawn ms", "Arena KiB", "ms/day", "us/tile/day");
+    for (int width = 128; width <= options.mBenchMapWidth; width *= 2)
+    {
+        const int height = width / 2;
+
+        double serialMs, parallelMs;
+        if (BenchmarkHeightMap(options.mMapSeed, width, height, serialMs, parallelMs) == false)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Parallel height map differs from the serial one at %dx%d", width, height);
+            return 1;
+        }
+
+        flecs::world ecs;
+
+        const auto start = std::chrono::steady_clock::now();
+        if (SetupSimulation(ecs, options, width, height) == false)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to initialize simulation");
+            return 1;
+        }
+        const auto generated = std::chrono::steady_clock::now();
+        const auto &arena = ecs.get<MapGenArena>();
+        const double spawnMs = arena.spawn_ms;
+        const size_t arenaKiB = arena.Bytes() / 1024;
+        const uint64_t days = RunDays(ecs, options.mBenchDays);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double tiles = static_cast<double>(width) * height;
+        const std::chrono::duration<double, std::milli> generation = generated - start;
+        const std::chrono::duration<double, std::milli> simulation = end - generated;
+        const double msPerDay = days != 0 ? simulation.count() / static_cast<double>(days) : 0.0;
+        const std::string size = std::to_string(width) + "x" + std::to_string(height);
+        SDL_Log("%10s %10.0f %14.1f %14.1f %14.1f %12.1f %12zu %14.3f %14.5f", size.c_str(), tiles, serialMs,
+                parallelMs, generation.count(), spawnMs, arenaKiB, msPerDay, msPerDay * 1000.0 / tiles);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::current_path(SDL_GetBasePath());
+
+    HeadlessOptions options;
+    if (ParseOptions(argc, argv, options) == false)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (options.mHelp)
+    {
+        PrintUsage(argv[0]);
+        return 0;
+    }
+
+    SetParallelThreadCount(std::max(options.mThreads, 1));
+
+    if (options.mBenchNoisePoints > 0)
+        return RunNoiseBenchmark(options);
+    if (options.mBenchPathsWidth > 0)
+        return RunPathsBenchmark(options);
+    if (options.mBenchMapWidth > 0)
+        return RunMapBenchmark(options);
+
+    flecs::world ecs(argc, argv);
+    if (SetupSimulation(ecs, options, options.mMapWidth, options.mMapHeight) == false)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to initialize simulation");
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t days = RunDays(ecs, options.mDays);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    SDL_Log("Simulated %" PRIu64 " days (%" PRIu64 " years) in %.3f s: %.1f days/s",
+            days, days / 360, elapsed.count(), days / elapsed.count());
+
+    return 0;
+}
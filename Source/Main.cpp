@@ -3,6 +3,14 @@
 #include <thread>
 
 #include "Game.hpp"
+#include "Systems/GameTime.hpp"
+
+// Runs the simulation steps accumulated by the last frame, then the frame pipeline
+static int RunFrame(ecs_world_t *world, const ecs_app_desc_t *desc)
+{
+    RunPendingSimulationSteps(flecs::world(world));
+    return !ecs_progress(world, desc->delta_time);
+}
 
 int main(int argc, char* argv[])
 {
@@ -15,6 +23,7 @@ int main(int argc, char* argv[])
         return 1;
     }
     const auto numThreads = std::thread::hardware_concurrency();
+    ecs_app_set_frame_action(RunFrame);
     return ecs.app()
         .enable_rest()
         .enable_stats()
@@ -0,0 +1,188 @@
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Worker threads kept alive between ParallelFor calls. The calling thread takes chunks too,
+    // so a pool of n threads has n - 1 workers.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t threads)
+        {
+            mWorkers.reserve(threads - 1);
+            try
+            {
+                for (size_t i = 1; i < threads; ++i)
+                    mWorkers.emplace_back([this] { WorkerLoop(); });
+            }
+            catch (...)
+            {
+                Stop();
+                throw;
+            }
+        }
+
+        ~ThreadPool() { Stop(); }
+
+        [[nodiscard]] size_t ThreadCount() const { return mWorkers.size() + 1; }
+
+        // Runs run(chunk) for every chunk in [0, chunks), rethrowing the first exception once all of them finished
+        void Run(size_t chunks, const std::function<void(size_t)> &run)
+        {
+            std::lock_guard runLock(mRunMutex);
+            {
+                std::lock_guard lock(mMutex);
+                mJob = &run;
+                mChunks = chunks;
+                mNextChunk = 0;
+                mPendingChunks = chunks;
+                mError = nullptr;
+                ++mGeneration;
+            }
+            mWake.notify_all();
+
+            RunChunks();
+
+            std::unique_lock lock(mMutex);
+            mDone.wait(lock, [this] { return mPendingChunks == 0; });
+            mJob = nullptr;
+            if (mError) std::rethrow_exception(std::exchange(mError, nullptr));
+        }
+
+        // True while the thread runs a chunk, nested ParallelFor calls then run inline instead of waiting on the pool
+        static bool InChunk() { return sInChunk; }
+
+    private:
+        void WorkerLoop()
+        {
+            uint64_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mMutex);
+                    mWake.wait(lock, [&] { return mStopping || mGeneration != seen; });
+                    if (mStopping) return;
+                    seen = mGeneration;
+                }
+                RunChunks();
+            }
+        }
+
+        void RunChunks()
+        {
+            while (true)
+            {
+                const std::function<void(size_t)> *job;
+                size_t chunk;
+                {
+                    std::lock_guard lock(mMutex);
+                    if (mJob == nullptr || mNextChunk >= mChunks) return;
+                    job = mJob;
+                    chunk = mNextChunk++;
+                }
+
+                std::exception_ptr error;
+                sInChunk = true;
+                try
+                {
+                    (*job)(chunk);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                sInChunk = false;
+
+                std::lock_guard lock(mMutex);
+                if (error && !mError) mError = error;
+                if (--mPendingChunks == 0) mDone.notify_all();
+            }
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard lock(mMutex);
+                mStopping = true;
+            }
+            mWake.notify_all();
+            for (auto &worker : mWorkers)
+                if (worker.joinable()) worker.join();
+        }
+
+        std::vector<std::thread> mWorkers;
+        std::mutex mRunMutex;
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        std::condition_variable mDone;
+        const std::function<void(size_t)> *mJob = nullptr;
+        size_t mChunks = 0;
+        size_t mNextChunk = 0;
+        size_t mPendingChunks = 0;
+        uint64_t mGeneration = 0;
+        std::exception_ptr mError;
+        bool mStopping = false;
+
+        static thread_local bool sInChunk;
+    };
+
+    thread_local bool ThreadPool::sInChunk = false;
+
+    std::unique_ptr<ThreadPool> &Pool()
+    {
+        static std::unique_ptr<ThreadPool> pool;
+        return pool;
+    }
+}
+
+size_t GetParallelThreadCount()
+{
+    auto &pool = Pool();
+    if (!pool) SetParallelThreadCount(std::max(1u, std::thread::hardware_concurrency()));
+    return pool->ThreadCount();
+}
+
+void SetParallelThreadCount(size_t count)
+{
+    count = std::max<size_t>(count, 1);
+    auto &pool = Pool();
+    if (pool && pool->ThreadCount() == count) return;
+
+    pool.reset();
+    pool = std::make_unique<ThreadPool>(count);
+}
+
+size_t ParallelChunkCount(size_t count, size_t grain)
+{
+    if (count == 0) return 0;
+    grain = std::max<size_t>(grain, 1);
+    return std::clamp<size_t>((count + grain - 1) / grain, 1, GetParallelThreadCount());
+}
+
+void ParallelFor(size_t count, size_t grain, const std::function<void(const ParallelRange &)> &body)
+{
+    const size_t chunks = ParallelChunkCount(count, grain);
+    const std::function<void(size_t)> run = [&](size_t chunk)
+    {
+        body(ParallelRange { chunk, count * chunk / chunks, count * (chunk + 1) / chunks });
+    };
+
+    if (chunks <= 1 || ThreadPool::InChunk())
+    {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            run(chunk);
+        return;
+    }
+    Pool()->Run(chunks, run);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// Contiguous part of a ParallelFor range
+struct ParallelRange
+{
+    size_t mChunk;
+    size_t mBegin;
+    size_t mEnd;
+};
+
+// Number of threads used by ParallelFor, counting the calling thread. Setting it (re)creates the
+// worker pool, which otherwise starts with one thread per core on first use.
+size_t GetParallelThreadCount();
+void SetParallelThreadCount(size_t count);
+
+// Number of chunks ParallelFor splits count items into, for sizing per-chunk results
+size_t ParallelChunkCount(size_t count, size_t grain);
+
+// Splits [0, count) in contiguous chunks of at least grain items and runs them on the worker
+// pool and the calling thread, returning after all of them finished. The first exception thrown
+// by a chunk is rethrown here. Calls made from inside a chunk run inline.
+// The split only depends on count, grain and the thread count.
+void ParallelFor(size_t count, size_t grain, const std::function<void(const ParallelRange &)> &body);
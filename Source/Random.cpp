@@ -16,9 +16,15 @@ void Random::Init()
 
 void Random::Seed(unsigned int seed)
 {
+	sSeed = seed;
 	sGenerator.seed(seed);
 }
 
+unsigned int Random::GetSeed()
+{
+	return sSeed;
+}
+
 float Random::GetFloat()
 {
 	return GetFloatRange(0.0f, 1.0f);
@@ -49,3 +55,81 @@ glm::vec3 Random::GetVector(const glm::vec3& min, const glm::vec3& max)
 }
 
 std::mt19937 Random::sGenerator;
+unsigned int Random::sSeed = 0;
+
+namespace
+{
+	constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+	constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+	constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+	constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+
+	std::array<uint32_t, 4> Philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key)
+	{
+		for (int round = 0; round < 10; ++round)
+		{
+			const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+			const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+			ctr = {
+				static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+				static_cast<uint32_t>(p1),
+				static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+				static_cast<uint32_t>(p0),
+			};
+			key[0] += PHILOX_W0;
+			key[1] += PHILOX_W1;
+		}
+		return ctr;
+	}
+}
+
+RandomStream::RandomStream(RandomSubsystem subsystem, uint64_t entity, uint64_t day)
+	: mKey{ Random::GetSeed(), static_cast<uint32_t>(subsystem) }
+	// The last word counts the blocks of 4 numbers drawn
+	, mCounter{ static_cast<uint32_t>(entity), static_cast<uint32_t>(entity >> 32), static_cast<uint32_t>(day), 0 }
+{
+}
+
+uint32_t RandomStream::GetUInt()
+{
+	if (mNext == mBlock.size())
+	{
+		mBlock = Philox4x32(mCounter, mKey);
+		++mCounter[3];
+		mNext = 0;
+	}
+	return mBlock[mNext++];
+}
+
+float RandomStream::GetFloat()
+{
+	// 24 random bits, exactly representable in a float
+	return static_cast<float>(GetUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+float RandomStream::GetFloatRange(float min, float max)
+{
+	return min + (max - min) * GetFloat();
+}
+
+int RandomStream::GetIntRange(int min, int max)
+{
+	// Lemire's multiply and reject, unbiased for any range
+	const uint32_t range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1;
+	if (range == 0) return static_cast<int>(GetUInt());
+
+	uint64_t m = static_cast<uint64_t>(GetUInt()) * range;
+	if (static_cast<uint32_t>(m) < range)
+	{
+		const uint32_t threshold = (0u - range) % range;
+		while (static_cast<uint32_t>(m) < threshold)
+			m = static_cast<uint64_t>(GetUInt()) * range;
+	}
+	return static_cast<int>(static_cast<uint32_t>(min) + static_cast<uint32_t>(m >> 32));
+}
+
+glm::vec3 RandomStream::GetVector(const glm::vec3& min, const glm::vec3& max)
+{
+	glm::vec3 r = glm::vec3(GetFloat(), GetFloat(), GetFloat());
+	return min + (max - min) * r;
+}
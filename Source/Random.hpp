@@ -7,6 +7,8 @@
 // ----------------------------------------------------------------
 
 #pragma  once
+#include <array>
+#include <cstdint>
 #include <random>
 #include <glm/glm.hpp>
 
@@ -15,9 +17,10 @@ class Random
 public:
 	static void Init();
 
-	// Seed the generator with the specified int
+	// Seed the generator with the specified int, also the key of every RandomStream
 	// NOTE: You should generally not need to manually use this
 	static void Seed(unsigned int seed);
+	static unsigned int GetSeed();
 
 	// Get a float between 0.0f and 1.0f
 	static float GetFloat();
@@ -33,4 +36,44 @@ public:
 	static glm::vec3 GetVector(const glm::vec3& min, const glm::vec3& max);
 private:
 	static std::mt19937 sGenerator;
+	static unsigned int sSeed;
+};
+
+// Simulation subsystems, each one draws from its own independent streams
+enum class RandomSubsystem : uint32_t
+{
+	WorldGen,
+	Characters,
+	Diplomacy,
+	Estates,
+	Provinces,
+	Decisions,
+};
+
+// Counter-based generator (Philox4x32-10). The numbers drawn are a pure function of the
+// seed of Random::Seed, the subsystem, an entity id, the game day and the draw index,
+// so systems may run on any thread or order and a seed still replays the same game.
+// Meant to be constructed on the stack where the numbers are needed.
+class RandomStream
+{
+public:
+	RandomStream(RandomSubsystem subsystem, uint64_t entity, uint64_t day);
+
+	uint32_t GetUInt();
+
+	// Get a float between 0.0f and 1.0f
+	float GetFloat();
+
+	// Get a float from the specified range
+	float GetFloatRange(float min, float max);
+
+	// Get an int from the specified range
+	int GetIntRange(int min, int max);
+
+	glm::vec3 GetVector(const glm::vec3& min, const glm::vec3& max);
+private:
+	std::array<uint32_t, 2> mKey;
+	std::array<uint32_t, 4> mCounter;
+	std::array<uint32_t, 4> mBlock = {};
+	uint32_t mNext = 4;
 };
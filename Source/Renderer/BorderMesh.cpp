@@ -0,0 +1,105 @@
+#include "BorderMesh.hpp"
+#include <algorithm>
+#include <GL/glew.h>
+
+BorderMesh::BorderMesh()
+: mWidth(0)
+, mHeight(0)
+, mTileSize(0.0f)
+, mCapacity(0)
+, mDirtyFirst(1)
+, mDirtyLast(0)
+, mVertexBuffer(0)
+, mVertexArray(0)
+{
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+
+	glGenBuffers(1, &mVertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PrimitiveVertex),
+		(void*)offsetof(PrimitiveVertex, mPosition));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PrimitiveVertex),
+		(void*)offsetof(PrimitiveVertex, mColor));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+BorderMesh::~BorderMesh()
+{
+	glDeleteBuffers(1, &mVertexBuffer);
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+bool BorderMesh::Resize(int width, int height, float tileSize)
+{
+	if (width == mWidth && height == mHeight && tileSize == mTileSize) return false;
+
+	mWidth = width;
+	mHeight = height;
+	mTileSize = tileSize;
+	const size_t count = static_cast<size_t>(width) * height;
+	mVertices.assign(count * VERTICES_PER_TILE, PrimitiveVertex{});
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			SetTileEdges(x, y, false, false, glm::vec4(0.0f));
+	return true;
+}
+
+void BorderMesh::SetTileEdges(int x, int y, bool east, bool north, const glm::vec4 &color)
+{
+	const size_t tile = static_cast<size_t>(y) * mWidth + x;
+	PrimitiveVertex *v = mVertices.data() + tile * VERTICES_PER_TILE;
+
+	// Tile (x, y) is centered at (x, y) * mTileSize, its north east corner is shared by both edges
+	const glm::vec2 corner = (glm::vec2(x, y) + 0.5f) * mTileSize;
+	v[0] = {corner, color};
+	v[1] = {east ? corner - glm::vec2(0.0f, mTileSize) : corner, color};
+	v[2] = {corner, color};
+	v[3] = {north ? corner - glm::vec2(mTileSize, 0.0f) : corner, color};
+
+	if (mDirtyFirst > mDirtyLast)
+	{
+		mDirtyFirst = mDirtyLast = tile;
+	}
+	else
+	{
+		mDirtyFirst = std::min(mDirtyFirst, tile);
+		mDirtyLast = std::max(mDirtyLast, tile);
+	}
+}
+
+void BorderMesh::Upload()
+{
+	if (mDirtyFirst > mDirtyLast) return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	if (mVertices.size() > mCapacity)
+	{
+		glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(PrimitiveVertex), mVertices.data(), GL_DYNAMIC_DRAW);
+		mCapacity = mVertices.size();
+	}
+	else
+	{
+		const size_t first = mDirtyFirst * VERTICES_PER_TILE;
+		const size_t count = (mDirtyLast - mDirtyFirst + 1) * VERTICES_PER_TILE;
+		glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(PrimitiveVertex), count * sizeof(PrimitiveVertex),
+			mVertices.data() + first);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	mDirtyFirst = 1;
+	mDirtyLast = 0;
+}
+
+void BorderMesh::Draw(size_t firstTile, size_t numTiles) const
+{
+	if (numTiles == 0 || (firstTile + numTiles) * VERTICES_PER_TILE > mCapacity) return;
+
+	glBindVertexArray(mVertexArray);
+	glDrawArrays(GL_LINES, static_cast<GLint>(firstTile * VERTICES_PER_TILE),
+		static_cast<GLsizei>(numTiles * VERTICES_PER_TILE));
+}
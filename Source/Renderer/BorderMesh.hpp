@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "PrimitiveBatch.hpp"
+
+// Lines between the tiles of a grid, kept on the GPU. Every tile owns a fixed slot with its east and
+// north edges, so changing the edges of a few tiles only uploads the span of slots covering them.
+// Edges that aren't borders are stored collapsed to a point and produce no fragments.
+class BorderMesh
+{
+public:
+	BorderMesh();
+	~BorderMesh();
+
+	// Reallocates the slots of a width x height grid with every edge hidden, returns true if the size changed
+	bool Resize(int width, int height, float tileSize);
+
+	// Shows or hides the east and north edges of tile (x, y)
+	void SetTileEdges(int x, int y, bool east, bool north, const glm::vec4 &color);
+
+	// Uploads the slots changed since the last upload
+	void Upload();
+
+	// Draws the edges of tiles [firstTile, firstTile + numTiles) in row-major order with the active
+	// shader, the VAO stays bound for further ranges
+	void Draw(size_t firstTile, size_t numTiles) const;
+
+private:
+	static constexpr int VERTICES_PER_TILE = 4;
+
+	std::vector<PrimitiveVertex> mVertices;
+	int mWidth;
+	int mHeight;
+	float mTileSize;
+	size_t mCapacity;
+	// Span of changed tiles, empty when mDirtyFirst > mDirtyLast
+	size_t mDirtyFirst;
+	size_t mDirtyLast;
+	unsigned int mVertexBuffer;
+	unsigned int mVertexArray;
+};
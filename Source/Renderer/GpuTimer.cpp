@@ -0,0 +1,44 @@
+#include "GpuTimer.hpp"
+#include <GL/glew.h>
+
+GpuTimer::GpuTimer()
+: mCurrent(0)
+, mPending(0)
+, mMilliseconds(0.0)
+{
+	glGenQueries(NUM_QUERIES, mQueries);
+}
+
+GpuTimer::~GpuTimer()
+{
+	glDeleteQueries(NUM_QUERIES, mQueries);
+}
+
+void GpuTimer::Begin()
+{
+	// Every query is in flight, drop the oldest one rather than waiting for it
+	if (mPending == NUM_QUERIES) mPending--;
+
+	glBeginQuery(GL_TIME_ELAPSED, mQueries[mCurrent]);
+}
+
+void GpuTimer::End()
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	mCurrent = (mCurrent + 1) % NUM_QUERIES;
+	mPending++;
+
+	// Read the completed queries, oldest first
+	while (mPending > 0)
+	{
+		const unsigned int query = mQueries[(mCurrent - mPending + NUM_QUERIES) % NUM_QUERIES];
+		GLint available = 0;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) break;
+
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+		mMilliseconds = static_cast<double>(nanoseconds) * 1e-6;
+		mPending--;
+	}
+}
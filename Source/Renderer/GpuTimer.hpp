@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+// GPU time of the commands between Begin and End, read back a few frames later so it never stalls
+class GpuTimer
+{
+public:
+	GpuTimer();
+	~GpuTimer();
+
+	// Only one timer may be running at a time
+	void Begin();
+	void End();
+
+	// Last result available, 0 until the first query completes
+	double GetMilliseconds() const { return mMilliseconds; }
+
+private:
+	static constexpr int NUM_QUERIES = 4;
+
+	unsigned int mQueries[NUM_QUERIES];
+	// Next query to start and number of queries waiting for a result
+	int mCurrent;
+	int mPending;
+	double mMilliseconds;
+};
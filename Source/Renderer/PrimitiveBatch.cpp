@@ -0,0 +1,81 @@
+#include "PrimitiveBatch.hpp"
+#include <cstring>
+#include <initializer_list>
+#include <GL/glew.h>
+
+PrimitiveBatch::PrimitiveBatch()
+: mStream(4096 * sizeof(PrimitiveVertex))
+, mVertexArray(0)
+{
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+
+	// Draws pick their vertices with the first index of glDrawArrays, the attributes start at 0
+	glBindBuffer(GL_ARRAY_BUFFER, mStream.GetBuffer());
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PrimitiveVertex),
+		(void*)offsetof(PrimitiveVertex, mPosition));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PrimitiveVertex),
+		(void*)offsetof(PrimitiveVertex, mColor));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+PrimitiveBatch::~PrimitiveBatch()
+{
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void PrimitiveBatch::AddLine(const glm::vec2 &a, const glm::vec2 &b, const glm::vec4 &color)
+{
+	mLines.push_back({a, color});
+	mLines.push_back({b, color});
+}
+
+void PrimitiveBatch::AddRectOutline(const glm::vec2 &min, const glm::vec2 &max, const glm::vec4 &color)
+{
+	const glm::vec2 a(min.x, max.y), b(max.x, min.y);
+	AddLine(min, b, color);
+	AddLine(b, max, color);
+	AddLine(max, a, color);
+	AddLine(a, min, color);
+}
+
+void PrimitiveBatch::AddRect(const glm::vec2 &min, const glm::vec2 &max, const glm::vec4 &color)
+{
+	const glm::vec2 a(min.x, max.y), b(max.x, min.y);
+	for (const glm::vec2 &p : {min, b, max, max, a, min})
+		mTriangles.push_back({p, color});
+}
+
+void PrimitiveBatch::Flush()
+{
+	const size_t count = mLines.size() + mTriangles.size();
+	if (count != 0)
+	{
+		int first = 0;
+		auto *vertices = static_cast<PrimitiveVertex*>(mStream.Map(count, sizeof(PrimitiveVertex), first));
+		if (vertices)
+		{
+			std::memcpy(vertices, mTriangles.data(), mTriangles.size() * sizeof(PrimitiveVertex));
+			std::memcpy(vertices + mTriangles.size(), mLines.data(), mLines.size() * sizeof(PrimitiveVertex));
+		}
+		mStream.Unmap();
+
+		if (vertices)
+		{
+			glBindVertexArray(mVertexArray);
+			if (!mTriangles.empty())
+				glDrawArrays(GL_TRIANGLES, first, static_cast<GLsizei>(mTriangles.size()));
+			if (!mLines.empty())
+				glDrawArrays(GL_LINES, first + static_cast<int>(mTriangles.size()), static_cast<GLsizei>(mLines.size()));
+			glBindVertexArray(0);
+		}
+	}
+
+	mLines.clear();
+	mTriangles.clear();
+	mStream.EndFrame();
+}
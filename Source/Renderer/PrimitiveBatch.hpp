@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "StreamBuffer.hpp"
+
+// Colored world space vertex of the primitive batch
+struct PrimitiveVertex
+{
+	glm::vec2 mPosition;
+	glm::vec4 mColor;
+};
+
+// Flat colored lines and triangles collected during the frame, such as outlines and markers,
+// uploaded together and drawn with one call per primitive type
+class PrimitiveBatch
+{
+public:
+	PrimitiveBatch();
+	~PrimitiveBatch();
+
+	void AddLine(const glm::vec2 &a, const glm::vec2 &b, const glm::vec4 &color);
+	void AddRectOutline(const glm::vec2 &min, const glm::vec2 &max, const glm::vec4 &color);
+	void AddRect(const glm::vec2 &min, const glm::vec2 &max, const glm::vec4 &color);
+
+	// Draws everything added since the last flush with the active shader, once per frame
+	void Flush();
+
+private:
+	std::vector<PrimitiveVertex> mLines;
+	std::vector<PrimitiveVertex> mTriangles;
+	StreamBuffer mStream;
+	unsigned int mVertexArray;
+};
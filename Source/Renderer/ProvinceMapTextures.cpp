@@ -0,0 +1,117 @@
+#include "ProvinceMapTextures.hpp"
+#include <GL/glew.h>
+
+namespace
+{
+	GLuint CreateNearestTexture()
+	{
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return texture;
+	}
+}
+
+ProvinceMapTextures::ProvinceMapTextures()
+: mTileTexture(0)
+, mPaletteTexture(0)
+, mWidth(0)
+, mHeight(0)
+, mPaletteSize(0)
+, mPalettePlayerRealm(0)
+{
+	mTileTexture = CreateNearestTexture();
+	mPaletteTexture = CreateNearestTexture();
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+ProvinceMapTextures::~ProvinceMapTextures()
+{
+	glDeleteTextures(1, &mTileTexture);
+	glDeleteTextures(1, &mPaletteTexture);
+}
+
+bool ProvinceMapTextures::Resize(int width, int height)
+{
+	if (width == mWidth && height == mHeight) return false;
+
+	mWidth = width;
+	mHeight = height;
+	glBindTexture(GL_TEXTURE_2D, mTileTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16UI, width, height, 0, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, nullptr);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return true;
+}
+
+void ProvinceMapTextures::SetTile(int x, int y, const TileTexel& texel)
+{
+	glBindTexture(GL_TEXTURE_2D, mTileTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, &texel);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void ProvinceMapTextures::SetTiles(const std::vector<TileTexel>& texels)
+{
+	if (texels.size() != static_cast<size_t>(mWidth) * mHeight) return;
+
+	glBindTexture(GL_TEXTURE_2D, mTileTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mWidth, mHeight, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, texels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+uint16_t ProvinceMapTextures::GetRealmSlot(uint64_t realm)
+{
+	if (realm == 0) return NO_REALM;
+
+	const auto iter = mRealmSlots.find(realm);
+	if (iter != mRealmSlots.end()) return iter->second;
+
+	// Past the last slot the realm is drawn as unowned
+	if (mSlotRealms.size() >= NO_REALM) return NO_REALM;
+
+	const auto slot = static_cast<uint16_t>(mSlotRealms.size());
+	mRealmSlots.emplace(realm, slot);
+	mSlotRealms.push_back(realm);
+	return slot;
+}
+
+void ProvinceMapTextures::UploadPalette(uint64_t playerRealm)
+{
+	mPalettePlayerRealm = playerRealm;
+	if (mPalette.empty()) return;
+
+	glBindTexture(GL_TEXTURE_2D, mPaletteTexture);
+	const int size = static_cast<int>(mPalette.size());
+	if (size != mPaletteSize)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, size, 1, 0, GL_RGBA, GL_FLOAT, mPalette.data());
+		mPaletteSize = size;
+	}
+	else
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RGBA, GL_FLOAT, mPalette.data());
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void ProvinceMapTextures::Reset()
+{
+	mRealmSlots.clear();
+	mSlotRealms.clear();
+	mPalette.clear();
+	mPaletteSize = 0;
+	mPalettePlayerRealm = 0;
+}
+
+void ProvinceMapTextures::SetActive(int tileUnit, int paletteUnit) const
+{
+	glActiveTexture(GL_TEXTURE0 + tileUnit);
+	glBindTexture(GL_TEXTURE_2D, mTileTexture);
+	glActiveTexture(GL_TEXTURE0 + paletteUnit);
+	glBindTexture(GL_TEXTURE_2D, mPaletteTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
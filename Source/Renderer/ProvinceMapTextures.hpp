@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Province attributes read by the map mode shader: a map-sized RGBA16UI texture
+// with one texel per tile and a palette texture with one RGBA32F texel per topmost realm
+class ProvinceMapTextures
+{
+public:
+	// Layout of a tile texel
+	struct TileTexel
+	{
+		uint16_t mRealmSlot; // Palette slot of the topmost realm, NO_REALM if none
+		uint16_t mCulture;
+		uint16_t mArmy;      // Clamped to 65535
+		uint16_t mFlags;
+	};
+
+	static constexpr uint16_t NO_REALM = 0xFFFF;
+
+	ProvinceMapTextures();
+	~ProvinceMapTextures();
+
+	// Reallocates the tile texture, returns true if the size changed
+	bool Resize(int width, int height);
+	int GetWidth() const { return mWidth; }
+	int GetHeight() const { return mHeight; }
+
+	// Uploads a single tile, or the whole map in row-major order
+	void SetTile(int x, int y, const TileTexel& texel);
+	void SetTiles(const std::vector<TileTexel>& texels);
+
+	// Palette slot of a realm, assigned on first use and stable afterwards
+	uint16_t GetRealmSlot(uint64_t realm);
+	const std::vector<uint64_t>& GetSlotRealms() const { return mSlotRealms; }
+
+	// One color per slot, the alpha channel carries the shader's per-realm value.
+	// Filled by the caller, then uploaded along with the player realm its relations were computed for.
+	std::vector<glm::vec4>& GetPalette() { return mPalette; }
+	void UploadPalette(uint64_t playerRealm);
+	int GetPaletteSize() const { return mPaletteSize; }
+	uint64_t GetPalettePlayerRealm() const { return mPalettePlayerRealm; }
+
+	// Forgets the realm slots and the palette, for a new map whose realms are all new entities
+	void Reset();
+
+	void SetActive(int tileUnit, int paletteUnit) const;
+
+private:
+	unsigned int mTileTexture;
+	unsigned int mPaletteTexture;
+	int mWidth;
+	int mHeight;
+	int mPaletteSize;
+	uint64_t mPalettePlayerRealm;
+
+	std::vector<glm::vec4> mPalette;
+	std::unordered_map<uint64_t, uint16_t> mRealmSlots;
+	std::vector<uint64_t> mSlotRealms;
+};
@@ -10,6 +10,13 @@
 #include "Shader.hpp"
 #include "VertexArray.hpp"
 #include "Texture.hpp"
+#include "TileInstanceBuffer.hpp"
+#include "ProvinceMapTextures.hpp"
+#include "GpuTimer.hpp"
+#include "TextureArray.hpp"
+#include "PrimitiveBatch.hpp"
+#include "BorderMesh.hpp"
+#include "SpriteBatch.hpp"
 
 Renderer::Renderer()
 {}
@@ -17,9 +24,6 @@ Renderer::Renderer()
 Renderer::~Renderer()
 {
     Shutdown();
-
-    delete mSpriteVerts;
-    mSpriteVerts = nullptr;
 }
 
 bool Renderer::Initialize(const Window &window)
@@ -70,8 +74,22 @@ bool Renderer::Initialize(const Window &window)
         return false;
     }
 
+    // Camera uniform block shared by every shader
+    glGenBuffers(1, &mCameraBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, mCameraBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), &mCameraBlock, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, mCameraBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
     // Create quad for drawing sprites
     CreateSpriteVerts();
+    mTileInstances = new TileInstanceBuffer();
+    mProvinceMap = new ProvinceMapTextures();
+    mMapTimer = new GpuTimer();
+    mMapModeTimer = new GpuTimer();
+    mPrimitives = new PrimitiveBatch();
+    mRealmBorders = new BorderMesh();
+    mSprites = new SpriteBatch();
 
     // Set the clear color to light grey
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -111,13 +129,47 @@ void Renderer::Shutdown()
     delete mMapShader;
     mMapShader = nullptr;
 
-    mPoliticalShader->Unload();
-    delete mPoliticalShader;
-    mPoliticalShader = nullptr;
+    mPrimitiveShader->Unload();
+    delete mPrimitiveShader;
+    mPrimitiveShader = nullptr;
+
+    mSpriteShader->Unload();
+    delete mSpriteShader;
+    mSpriteShader = nullptr;
+
+    mProvinceMapShader->Unload();
+    delete mProvinceMapShader;
+    mProvinceMapShader = nullptr;
+
+    // GL objects are deleted while their context is still alive
+    delete mSpriteVerts;
+    mSpriteVerts = nullptr;
 
-    mHeatMapShader->Unload();
-    delete mHeatMapShader;
-    mHeatMapShader = nullptr;
+    delete mTileInstances;
+    mTileInstances = nullptr;
+
+    delete mProvinceMap;
+    mProvinceMap = nullptr;
+
+    delete mTileSprites;
+    mTileSprites = nullptr;
+
+    delete mPrimitives;
+    mPrimitives = nullptr;
+
+    delete mRealmBorders;
+    mRealmBorders = nullptr;
+
+    delete mSprites;
+    mSprites = nullptr;
+
+    delete mMapTimer;
+    mMapTimer = nullptr;
+    delete mMapModeTimer;
+    mMapModeTimer = nullptr;
+
+    glDeleteBuffers(1, &mCameraBuffer);
+    mCameraBuffer = 0;
 
 
     if (mContext)
@@ -130,6 +182,13 @@ void Renderer::Shutdown()
 void Renderer::DrawRect(const glm::vec2 &position, const glm::vec2 &size, float rotation, const glm::vec3 &color,
                         const glm::vec2 &cameraPos, RendererMode mode)
 {
+    // Filled rects are batched, outlines still need their own line loop
+    if (mode == RendererMode::TRIANGLES)
+    {
+        SubmitSprite(position, size, rotation, color, nullptr, glm::vec4(0, 0, 1, 1), cameraPos, false, 0.0f);
+        return;
+    }
+
     auto model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(position.x, position.y, 0.0f));
     model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
@@ -141,13 +200,20 @@ void Renderer::DrawTexture(const glm::vec2 &position, const glm::vec2 &size, flo
                            Texture *texture, const glm::vec4 &textureRect, const glm::vec2 &cameraPos, bool flip,
                            float textureFactor)
 {
-    float flipFactor = flip ? -1.0f : 1.0f;
+    SubmitSprite(position, size, rotation, color, texture, textureRect, cameraPos, flip, textureFactor);
+}
 
-    auto model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position.x, position.y, 0.0f));
-    model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(size.x * flipFactor, size.y, 1.0f));
-    Draw(RendererMode::TRIANGLES, model, cameraPos, mSpriteVerts, color, texture, textureRect, textureFactor);
+void Renderer::SubmitSprite(const glm::vec2 &position, const glm::vec2 &size, float rotation, const glm::vec3 &color,
+                            const Texture *texture, const glm::vec4 &textureRect, const glm::vec2 &cameraPos, bool flip,
+                            float textureFactor)
+{
+    const float flipFactor = flip ? -1.0f : 1.0f;
+    mSprites->Add({
+        .mPositionSize = glm::vec4(position - cameraPos, size.x * flipFactor, size.y),
+        .mColor = glm::vec4(color, texture ? textureFactor : 0.0f),
+        .mTextureRect = textureRect,
+        .mRotation = rotation,
+    }, texture);
 }
 
 void Renderer::DrawGeometry(const glm::vec2 &position, const glm::vec2 &size, float rotation, const glm::vec3 &color,
@@ -201,10 +267,34 @@ void Renderer::UpdateOrthographicMatrix(int width, int height)
 {
     const float x = static_cast<float>(width), y = static_cast<float>(height);
     mOrthoProjection = glm::ortho(x * -.5f, x * .5f, y * -.5f, y * .5f, -1.0f, 1.0f);
-    mBaseShader->SetMatrixUniform("uOrthoProj", mOrthoProjection);
+    mCameraBlock.mOrthoProj = mOrthoProjection;
+    glBindBuffer(GL_UNIFORM_BUFFER, mCameraBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &mCameraBlock);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
     glViewport(0, 0, width, height);
 }
 
+void Renderer::FlushPrimitives()
+{
+    mPrimitiveShader->SetActive();
+    mPrimitives->Flush();
+
+    mSpriteShader->SetActive();
+    mSprites->Flush();
+}
+
+void Renderer::UpdateCameraBlock(const glm::mat4 &view, const glm::mat4 &proj, const glm::vec2 &mousePos,
+                                 const glm::vec2 &mouseWorld)
+{
+    mCameraBlock.mView = view;
+    mCameraBlock.mProj = proj;
+    mCameraBlock.mMousePos = mousePos;
+    mCameraBlock.mMouseWorld = mouseWorld;
+    glBindBuffer(GL_UNIFORM_BUFFER, mCameraBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &mCameraBlock);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 void Renderer::Draw(RendererMode mode, const glm::mat4 &modelMatrix, const glm::vec2 &cameraPos, VertexArray *vertices,
                     const glm::vec3 &color, Texture *texture, const glm::vec4 &textureRect, float textureFactor)
 {
@@ -255,13 +345,18 @@ bool Renderer::LoadShaders()
         return false;
     }
 
-    mPoliticalShader = new Shader();
-    if (!mPoliticalShader->Load(std::filesystem::path(SDL_GetBasePath()) / "Shaders/Political")) {
+    mProvinceMapShader = new Shader();
+    if (!mProvinceMapShader->Load(std::filesystem::path(SDL_GetBasePath()) / "Shaders/ProvinceMap")) {
+        return false;
+    }
+
+    mPrimitiveShader = new Shader();
+    if (!mPrimitiveShader->Load(std::filesystem::path(SDL_GetBasePath()) / "Shaders/Primitive")) {
         return false;
     }
 
-    mHeatMapShader = new Shader();
-    if (!mHeatMapShader->Load(std::filesystem::path(SDL_GetBasePath()) / "Shaders/HeatMap")) {
+    mSpriteShader = new Shader();
+    if (!mSpriteShader->Load(std::filesystem::path(SDL_GetBasePath()) / "Shaders/Sprite")) {
         return false;
     }
 
@@ -2,6 +2,7 @@
 #include <string>
 #include <unordered_map>
 #include <glm/glm.hpp>
+#include "Renderer/Shader.hpp"
 #include "Renderer/VertexArray.hpp"
 #include "Renderer/Texture.hpp"
 #include "Components/Window.hpp"
@@ -20,6 +21,8 @@ struct Renderer
 	bool Initialize(const Window &window);
 	void Shutdown();
 
+    // TRIANGLES rects are queued through SubmitSprite and drawn by FlushPrimitives, LINES rects are drawn
+    // right away. A fill therefore covers every outline of the same frame, whatever the call order.
     void DrawRect(const glm::vec2 &position, const glm::vec2 &size,  float rotation,
                   const glm::vec3 &color, const glm::vec2 &cameraPos, RendererMode mode);
 
@@ -32,6 +35,14 @@ struct Renderer
     void DrawGeometry(const glm::vec2 &position, const glm::vec2 &size,  float rotation,
                       const glm::vec3 &color, const glm::vec2 &cameraPos, VertexArray *vertexArray, RendererMode mode);
 
+    // Queues a screen space quad in the sprite batch, drawn with the other sprites of its texture
+    // when the frame is presented. A null texture draws the plain color.
+    void SubmitSprite(const glm::vec2 &position, const glm::vec2 &size, float rotation,
+                      const glm::vec3 &color, const Texture *texture = nullptr,
+                      const glm::vec4 &textureRect = glm::vec4(0, 0, 1, 1),
+                      const glm::vec2 &cameraPos = glm::vec2(0.0f), bool flip = false,
+                      float textureFactor = 1.0f);
+
     void Clear();
     void Present();
 
@@ -39,6 +50,13 @@ struct Renderer
 
 	void UpdateOrthographicMatrix(int width, int height);
 
+	// Draws the primitives and sprites batched during the frame, called once before presenting
+	void FlushPrimitives();
+
+	// Uploads the camera of this frame to the Camera uniform block
+	void UpdateCameraBlock(const glm::mat4 &view, const glm::mat4 &proj, const glm::vec2 &mousePos,
+	                       const glm::vec2 &mouseWorld);
+
 	// OpenGL context
 	SDL_GLContext mContext = nullptr;
 
@@ -56,18 +74,48 @@ struct Renderer
 
 	// Map Shader
 	class Shader* mMapShader = nullptr;
-	class Shader* mPoliticalShader = nullptr;
-	class Shader* mHeatMapShader = nullptr;
+	// Political, cultural, diplomatic and army map modes
+	class Shader* mProvinceMapShader = nullptr;
+	// Flat colored world space lines and triangles
+	class Shader* mPrimitiveShader = nullptr;
+	// Instanced screen space sprites
+	class Shader* mSpriteShader = nullptr;
 
     // Sprite vertex array
     class VertexArray * mSpriteVerts = nullptr;
 
+    // Instanced quads of the map tiles
+    class TileInstanceBuffer * mTileInstances = nullptr;
+
+    // Screen space quads, flushed once per frame
+    class SpriteBatch * mSprites = nullptr;
+
+    // Borders between the topmost realms of the map
+    class BorderMesh * mRealmBorders = nullptr;
+
+    // Outlines and markers drawn in world space, flushed once per frame
+    class PrimitiveBatch * mPrimitives = nullptr;
+
+    // Tile sprites of the map, one layer per sprite
+    class TextureArray * mTileSprites = nullptr;
+
+    // Province attributes of the map modes
+    class ProvinceMapTextures * mProvinceMap = nullptr;
+
+    // GPU time of the tile map and of the map mode overlay
+    class GpuTimer * mMapTimer = nullptr;
+    class GpuTimer * mMapModeTimer = nullptr;
+
 	// Window
 	SDL_Window* mWindow = nullptr;
 
 	// Ortho projection for 2D shaders
 	glm::mat4 mOrthoProjection{};
 
+	// Uniform buffer of the Camera block, bound to CAMERA_BLOCK_BINDING
+	unsigned int mCameraBuffer = 0;
+	CameraBlock mCameraBlock;
+
     // Map of textures loaded
     std::unordered_map<std::string, class Texture*> mTextures;
 
@@ -35,7 +35,13 @@ bool Shader::Load(const std::filesystem::path& name)
 	glLinkProgram(mShaderProgram);
 
 	// Verify that the program linked successfully
-	return IsValidProgram();
+	if (!IsValidProgram())
+	{
+		return false;
+	}
+
+	CacheUniforms();
+	return true;
 }
 
 void Shader::Unload()
@@ -48,6 +54,7 @@ void Shader::Unload()
 	mShaderProgram = 0;
 	mVertexShader = 0;
 	mFragShader = 0;
+	mUniformLocations.clear();
 }
 
 void Shader::SetActive() const
@@ -58,65 +65,64 @@ void Shader::SetActive() const
 
 void Shader::SetVectorUniform(const char* name, const glm::vec2& vector) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    const GLint loc = GetUniformLocation(name);
+    if (loc == -1)
+        return;
 
-    // Send the vector data to the uniform
     glUniform2fv(loc, 1, glm::value_ptr(vector));
 }
 
 void Shader::SetVectorUniform(const char* name, const glm::vec3& vector) const
 {
-	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+	const GLint loc = GetUniformLocation(name);
+	if (loc == -1)
+		return;
 
-	// Send the vector data to the uniform
 	glUniform3fv(loc, 1, glm::value_ptr(vector));
 }
 
 void Shader::SetVectorUniform(const char* name, const glm::vec4& vector) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    const GLint loc = GetUniformLocation(name);
+    if (loc == -1)
+        return;
 
-    // Send the vector data to the uniform
     glUniform4fv(loc, 1, glm::value_ptr(vector));
 }
 
 void Shader::SetMatrixUniform(const char* name, const glm::mat4& matrix) const
 {
-	// Find the uniform by this name
-	const GLint loc = glGetUniformLocation(mShaderProgram, name);
-
-	if (loc == GL_INVALID_VALUE)
+	const GLint loc = GetUniformLocation(name);
+	if (loc == -1)
 		return;
 
-	// Send the matrix data to the uniform
 	glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
 void Shader::SetFloatUniform(const char *name, float value) const
 {
-    // Find the uniform by this name
-    const GLint loc = glGetUniformLocation(mShaderProgram, name);
-
-	if (loc == GL_INVALID_VALUE)
+    const GLint loc = GetUniformLocation(name);
+	if (loc == -1)
 		return;
 
-	// Send the float data to the uniform
     glUniform1f(loc, value);
 }
 
 void Shader::SetIntegerUniform(const char *name, int value) const
 {
-	const GLint loc = glGetUniformLocation(mShaderProgram, name);
-
-	if (loc == GL_INVALID_VALUE)
+	const GLint loc = GetUniformLocation(name);
+	if (loc == -1)
 		return;
 
 	glUniform1i(loc, value);
 }
 
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	const auto iter = mUniformLocations.find(name);
+	return iter != mUniformLocations.end() ? iter->second : -1;
+}
+
 bool Shader::CompileShader(const std::filesystem::path& fileName, GLenum shaderType, GLuint& outShader)
 {
 	// Open file
@@ -187,3 +193,34 @@ bool Shader::IsValidProgram() const
 
 	return true;
 }
+
+void Shader::CacheUniforms()
+{
+	mUniformLocations.clear();
+
+	GLint count = 0;
+	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORMS, &count);
+	for (GLint i = 0; i < count; ++i)
+	{
+		char name[256];
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(mShaderProgram, i, sizeof(name), &length, &size, &type, name);
+
+		// Members of uniform blocks have no location
+		const GLint loc = glGetUniformLocation(mShaderProgram, name);
+		if (loc == -1)
+			continue;
+
+		// Arrays are reported as "name[0]", but set by their plain name
+		std::string key(name, length);
+		if (key.ends_with("[0]"))
+			key.resize(key.size() - 3);
+		mUniformLocations.emplace(std::move(key), loc);
+	}
+
+	const GLuint cameraBlock = glGetUniformBlockIndex(mShaderProgram, "Camera");
+	if (cameraBlock != GL_INVALID_INDEX)
+		glUniformBlockBinding(mShaderProgram, cameraBlock, CAMERA_BLOCK_BINDING);
+}
@@ -2,8 +2,22 @@
 #include <filesystem>
 #include <GL/glew.h>
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
+// Binding point of the "Camera" uniform block, shared by every program
+constexpr GLuint CAMERA_BLOCK_BINDING = 0;
+
+// std140 layout of the "Camera" uniform block, see Renderer::mCameraBuffer
+struct CameraBlock
+{
+	glm::mat4 mView{1.0f};
+	glm::mat4 mProj{1.0f};
+	glm::mat4 mOrthoProj{1.0f};
+	glm::vec2 mMousePos{0.0f};
+	glm::vec2 mMouseWorld{0.0f}; // mMousePos unprojected once on the CPU
+};
+
 class Shader
 {
 public:
@@ -26,6 +40,9 @@ public:
     void SetFloatUniform(const char* name, float value) const;
     void SetIntegerUniform(const char *name, int value) const;
 
+	// Location cached at link time, -1 if the program has no such uniform
+	GLint GetUniformLocation(const char* name) const;
+
 	// Tries to compile the specified shader
 	bool CompileShader(const std::filesystem::path& fileName, GLenum shaderType, GLuint& outShader);
 
@@ -34,8 +51,13 @@ public:
 	// Tests whether vertex/fragment programs link
 	bool IsValidProgram() const;
 
+	// Fills mUniformLocations and binds the Camera block
+	void CacheUniforms();
+
 	// Store the shader object IDs
 	GLuint mVertexShader;
 	GLuint mFragShader;
 	GLuint mShaderProgram;
+
+	std::unordered_map<std::string, GLint> mUniformLocations;
 };
@@ -0,0 +1,132 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <cstring>
+#include <GL/glew.h>
+#include "Texture.hpp"
+
+namespace
+{
+	// Points the instance attributes of the bound VAO at the given instance, GL 4.1 has no base instance
+	void SetInstanceOffset(unsigned int instanceBuffer, size_t first)
+	{
+		const size_t offset = first * sizeof(SpriteInstance);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+			(void*)(offset + offsetof(SpriteInstance, mPositionSize)));
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+			(void*)(offset + offsetof(SpriteInstance, mColor)));
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+			(void*)(offset + offsetof(SpriteInstance, mTextureRect)));
+		glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+			(void*)(offset + offsetof(SpriteInstance, mRotation)));
+	}
+}
+
+SpriteBatch::SpriteBatch()
+: mStream(256 * sizeof(SpriteInstance))
+, mNumDrawCalls(0)
+, mVertexBuffer(0)
+, mIndexBuffer(0)
+, mVertexArray(0)
+{
+	// Same quad as the sprite verts
+	constexpr float vertices[] = {
+		//   POSITION | TEXTURE
+		.5f,  .5f,        1.0f, 0.0f,
+		.5f, -.5f,        1.0f, 1.0f,
+		-.5f, -.5f,        0.0f, 1.0f,
+		-.5f,  .5f,        0.0f, 0.0f
+	};
+	constexpr unsigned int indices[] = {
+		0, 1, 2,
+		2, 3, 0
+	};
+	constexpr unsigned int VERTEX_SIZE_BYTES = 4 * sizeof(float);
+
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+
+	glGenBuffers(1, &mVertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE_BYTES, (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE_BYTES, (void*)(2 * sizeof(float)));
+
+	// Instance attributes advance once per quad
+	for (unsigned int attribute = 2; attribute <= 5; ++attribute)
+	{
+		glEnableVertexAttribArray(attribute);
+		glVertexAttribDivisor(attribute, 1);
+	}
+	SetInstanceOffset(mStream.GetBuffer(), 0);
+
+	glGenBuffers(1, &mIndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+	glDeleteBuffers(1, &mVertexBuffer);
+	glDeleteBuffers(1, &mIndexBuffer);
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void SpriteBatch::Add(const SpriteInstance &sprite, const Texture *texture)
+{
+	mEntries.push_back({texture, sprite});
+}
+
+void SpriteBatch::Flush()
+{
+	mNumDrawCalls = 0;
+	if (!mEntries.empty())
+	{
+		// Stable, so sprites sharing a texture keep their submission order
+		std::stable_sort(mEntries.begin(), mEntries.end(), [](const Entry &a, const Entry &b)
+		{
+			return a.mTexture < b.mTexture;
+		});
+		mSorted.resize(mEntries.size());
+		for (size_t i = 0; i < mEntries.size(); ++i)
+			mSorted[i] = mEntries[i].mSprite;
+
+		int first = 0;
+		void *instances = mStream.Map(mSorted.size(), sizeof(SpriteInstance), first);
+		if (instances)
+			std::memcpy(instances, mSorted.data(), mSorted.size() * sizeof(SpriteInstance));
+		mStream.Unmap();
+
+		if (instances)
+		{
+			glBindVertexArray(mVertexArray);
+			for (size_t begin = 0; begin < mEntries.size();)
+			{
+				const Texture *texture = mEntries[begin].mTexture;
+				size_t end = begin + 1;
+				while (end < mEntries.size() && mEntries[end].mTexture == texture) ++end;
+
+				if (texture)
+					texture->SetActive();
+				else
+					glBindTexture(GL_TEXTURE_2D, 0);
+
+				SetInstanceOffset(mStream.GetBuffer(), first + begin);
+				glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(end - begin));
+				mNumDrawCalls++;
+				begin = end;
+			}
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
+
+	mEntries.clear();
+	mStream.EndFrame();
+}
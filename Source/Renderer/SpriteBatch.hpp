@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "StreamBuffer.hpp"
+
+// Per-sprite data of the batched draw, read by the Sprite shader
+struct SpriteInstance
+{
+	glm::vec4 mPositionSize;  // Screen space center and size
+	glm::vec4 mColor;         // Color, then the texture factor in w
+	glm::vec4 mTextureRect;   // (u0, v0, u size, v size)
+	float mRotation;
+};
+
+// Screen space quads collected during the frame. Flush sorts them by texture, uploads them together
+// and draws each run of sprites sharing a texture with one instanced call.
+class SpriteBatch
+{
+public:
+	SpriteBatch();
+	~SpriteBatch();
+
+	// A null texture draws the plain color
+	void Add(const SpriteInstance &sprite, const class Texture *texture);
+
+	// Draws every sprite added since the last flush with the active shader, once per frame
+	void Flush();
+
+	size_t GetNumDrawCalls() const { return mNumDrawCalls; }
+
+private:
+	struct Entry
+	{
+		const class Texture *mTexture;
+		SpriteInstance mSprite;
+	};
+
+	std::vector<Entry> mEntries;
+	std::vector<SpriteInstance> mSorted;
+	StreamBuffer mStream;
+	size_t mNumDrawCalls;
+	unsigned int mVertexBuffer;
+	unsigned int mIndexBuffer;
+	unsigned int mVertexArray;
+};
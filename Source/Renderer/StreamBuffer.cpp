@@ -0,0 +1,79 @@
+#include "StreamBuffer.hpp"
+#include <GL/glew.h>
+
+StreamBuffer::StreamBuffer(size_t frameBytes)
+: mBuffer(0)
+, mFrameBytes(0)
+, mFrame(0)
+, mHead(0)
+, mFences{}
+{
+	glGenBuffers(1, &mBuffer);
+	Grow(frameBytes);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	for (GLsync fence : mFences)
+		if (fence) glDeleteSync(fence);
+	glDeleteBuffers(1, &mBuffer);
+}
+
+void StreamBuffer::Grow(size_t frameBytes)
+{
+	// Draws already issued keep reading the old storage, so the fences no longer guard anything
+	for (GLsync &fence : mFences)
+	{
+		if (fence) glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	mFrameBytes = frameBytes;
+	mHead = 0;
+	glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+	glBufferData(GL_ARRAY_BUFFER, mFrameBytes * NUM_FRAMES, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void* StreamBuffer::Map(size_t count, size_t stride, int &firstVertex)
+{
+	const size_t bytes = count * stride;
+	const size_t regionStart = static_cast<size_t>(mFrame) * mFrameBytes;
+	// Vertex indices count from the start of the buffer, so align the offset to the stride
+	size_t offset = (regionStart + mHead + stride - 1) / stride * stride;
+	if (offset + bytes > regionStart + mFrameBytes)
+	{
+		size_t frameBytes = mFrameBytes * 2;
+		while (frameBytes < bytes + stride) frameBytes *= 2;
+		Grow(frameBytes);
+		offset = (static_cast<size_t>(mFrame) * mFrameBytes + stride - 1) / stride * stride;
+	}
+
+	mHead = offset + bytes - static_cast<size_t>(mFrame) * mFrameBytes;
+	firstVertex = static_cast<int>(offset / stride);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+	return glMapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void StreamBuffer::Unmap()
+{
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamBuffer::EndFrame()
+{
+	mFences[mFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	mFrame = (mFrame + 1) % NUM_FRAMES;
+	mHead = 0;
+
+	// The next region was last drawn NUM_FRAMES frames ago, usually long finished
+	if (GLsync fence = mFences[mFrame])
+	{
+		glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		glDeleteSync(fence);
+		mFences[mFrame] = nullptr;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+// Vertex buffer for geometry rewritten every frame. The buffer is split in one region per frame in
+// flight; a frame maps its own region unsynchronized and fences it once drawn, so writing never
+// waits on draws of the previous frames unless the GPU is a whole ring behind.
+class StreamBuffer
+{
+public:
+	explicit StreamBuffer(size_t frameBytes);
+	~StreamBuffer();
+
+	// Maps room for count vertices of the given stride in this frame's region, growing the buffer
+	// when it doesn't fit. firstVertex is the index to give to glDrawArrays for the first vertex.
+	void* Map(size_t count, size_t stride, int &firstVertex);
+	void Unmap();
+
+	// Fences the region written this frame and moves to the next one
+	void EndFrame();
+
+	unsigned int GetBuffer() const { return mBuffer; }
+
+private:
+	static constexpr int NUM_FRAMES = 3;
+
+	// Orphans the storage with regions of at least frameBytes
+	void Grow(size_t frameBytes);
+
+	unsigned int mBuffer;
+	size_t mFrameBytes;
+	int mFrame;
+	// Bytes used in the current region
+	size_t mHead;
+	struct __GLsync *mFences[NUM_FRAMES];
+};
@@ -36,7 +36,6 @@ bool Texture::Load(const std::string &filePath)
     // Load to GPU
     GLuint textureID;
     glGenTextures(1, &textureID); // Cria textura na GPU
-    glActiveTexture(GL_TEXTURE0 + textureID); // Coloca textura na memória de textura
     glBindTexture(GL_TEXTURE_2D, textureID); // Ativa a textura no pipeline gráfico
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surf->w, surf->h, 0,
         GL_RGBA, GL_UNSIGNED_BYTE, surf->pixels);
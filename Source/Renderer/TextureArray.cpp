@@ -0,0 +1,123 @@
+#include <SDL3_image/SDL_image.h>
+#include <GL/glew.h>
+#include <cstring>
+#include "TextureArray.hpp"
+
+namespace
+{
+	// Loads an image as RGBA32, nullptr on failure
+	SDL_Surface* LoadRGBA(const std::string& filePath)
+	{
+		SDL_Surface* surf = IMG_Load(filePath.c_str());
+		if (!surf)
+		{
+			SDL_Log("Failed to load texture file %s", filePath.c_str());
+			return nullptr;
+		}
+
+		if (surf->format != SDL_PIXELFORMAT_RGBA32)
+		{
+			SDL_Surface* converted = SDL_ConvertSurface(surf, SDL_PIXELFORMAT_RGBA32);
+			SDL_DestroySurface(surf);
+			if (!converted)
+				SDL_Log("Failed to convert texture file %s", filePath.c_str());
+			surf = converted;
+		}
+		return surf;
+	}
+}
+
+TextureArray::TextureArray(int layerSize)
+: mTextureID(0)
+, mLayerSize(layerSize)
+, mNumLayers(0)
+{
+	glGenTextures(1, &mTextureID);
+}
+
+TextureArray::~TextureArray()
+{
+	glDeleteTextures(1, &mTextureID);
+}
+
+int TextureArray::AddStrip(const std::string& filePath)
+{
+	SDL_Surface* surf = LoadRGBA(filePath);
+	if (!surf) return -1;
+
+	if (surf->h != mLayerSize || surf->w % mLayerSize != 0)
+	{
+		SDL_Log("Texture strip %s is not made of %dpx tiles", filePath.c_str(), mLayerSize);
+		SDL_DestroySurface(surf);
+		return -1;
+	}
+
+	const int first = mNumLayers;
+	const int count = surf->w / mLayerSize;
+	const size_t rowBytes = static_cast<size_t>(mLayerSize) * 4;
+	mPixels.resize(static_cast<size_t>(first + count) * mLayerSize * rowBytes);
+	for (int tile = 0; tile < count; ++tile)
+	{
+		uint8_t* layer = mPixels.data() + static_cast<size_t>(first + tile) * mLayerSize * rowBytes;
+		for (int y = 0; y < mLayerSize; ++y)
+		{
+			const auto* src = static_cast<const uint8_t*>(surf->pixels) + y * surf->pitch + tile * rowBytes;
+			std::memcpy(layer + y * rowBytes, src, rowBytes);
+		}
+	}
+	mNumLayers += count;
+
+	SDL_DestroySurface(surf);
+	return first;
+}
+
+int TextureArray::AddImage(const std::string& filePath)
+{
+	SDL_Surface* surf = LoadRGBA(filePath);
+	if (!surf) return -1;
+
+	if (surf->w != mLayerSize || surf->h != mLayerSize)
+	{
+		SDL_Surface* scaled = SDL_ScaleSurface(surf, mLayerSize, mLayerSize, SDL_SCALEMODE_LINEAR);
+		SDL_DestroySurface(surf);
+		if (!scaled)
+		{
+			SDL_Log("Failed to scale texture file %s", filePath.c_str());
+			return -1;
+		}
+		surf = scaled;
+	}
+
+	const int layer = mNumLayers++;
+	const size_t rowBytes = static_cast<size_t>(mLayerSize) * 4;
+	mPixels.resize(static_cast<size_t>(mNumLayers) * mLayerSize * rowBytes);
+	uint8_t* dst = mPixels.data() + static_cast<size_t>(layer) * mLayerSize * rowBytes;
+	for (int y = 0; y < mLayerSize; ++y)
+		std::memcpy(dst + y * rowBytes, static_cast<const uint8_t*>(surf->pixels) + y * surf->pitch, rowBytes);
+
+	SDL_DestroySurface(surf);
+	return layer;
+}
+
+void TextureArray::Build()
+{
+	if (mNumLayers == 0) return;
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, mTextureID);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, mLayerSize, mLayerSize, mNumLayers, 0,
+		GL_RGBA, GL_UNSIGNED_BYTE, mPixels.data());
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+	// Pixel art up close, filtered mipmaps once tiles get smaller than their texels
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::SetActive(int index) const
+{
+	glActiveTexture(GL_TEXTURE0 + index);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, mTextureID);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Square sprites of the same size packed as the layers of a GL_TEXTURE_2D_ARRAY with mipmaps.
+// Layers are filled on the CPU and uploaded together by Build.
+class TextureArray
+{
+public:
+	explicit TextureArray(int layerSize);
+	~TextureArray();
+
+	// Adds each square tile of a horizontal strip as a layer, returns the first layer or -1 on failure
+	int AddStrip(const std::string& filePath);
+	// Adds an image scaled to the layer size, returns its layer or -1 on failure
+	int AddImage(const std::string& filePath);
+
+	// Uploads every layer and generates the mipmaps, call again after adding layers
+	void Build();
+
+	void SetActive(int index = 0) const;
+
+	[[nodiscard]] int GetLayerSize() const { return mLayerSize; }
+	[[nodiscard]] int GetNumLayers() const { return mNumLayers; }
+
+private:
+	unsigned int mTextureID;
+	int mLayerSize;
+	int mNumLayers;
+	// RGBA8 texels, one layer after the other
+	std::vector<uint8_t> mPixels;
+};
@@ -0,0 +1,119 @@
+#include "TileInstanceBuffer.hpp"
+#include <GL/glew.h>
+
+namespace
+{
+	// Points the instance attributes of the bound VAO at the given instance, GL 4.1 has no base instance
+	void SetInstanceOffset(unsigned int instanceBuffer, size_t first)
+	{
+		const size_t offset = first * sizeof(TileInstance);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(TileInstance),
+			(void*)(offset + offsetof(TileInstance, mPosition)));
+		glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, sizeof(TileInstance),
+			(void*)(offset + offsetof(TileInstance, mBaseTile)));
+	}
+}
+
+TileInstanceBuffer::TileInstanceBuffer()
+: mNumInstances(0)
+, mCapacity(0)
+, mVertexBuffer(0)
+, mIndexBuffer(0)
+, mInstanceBuffer(0)
+, mVertexArray(0)
+{
+	// Same quad as the sprite verts
+	constexpr float vertices[] = {
+		//   POSITION | TEXTURE
+		.5f,  .5f,        1.0f, 0.0f,
+		.5f, -.5f,        1.0f, 1.0f,
+		-.5f, -.5f,        0.0f, 1.0f,
+		-.5f,  .5f,        0.0f, 0.0f
+	};
+	constexpr unsigned int indices[] = {
+		0, 1, 2,
+		2, 3, 0
+	};
+	constexpr unsigned int VERTEX_SIZE_BYTES = 4 * sizeof(float);
+
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+
+	glGenBuffers(1, &mVertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE_BYTES, (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE_BYTES, (void*)(2 * sizeof(float)));
+
+	// Instance attributes advance once per quad
+	glGenBuffers(1, &mInstanceBuffer);
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	glEnableVertexAttribArray(3);
+	glVertexAttribDivisor(3, 1);
+	SetInstanceOffset(mInstanceBuffer, 0);
+
+	glGenBuffers(1, &mIndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+TileInstanceBuffer::~TileInstanceBuffer()
+{
+	glDeleteBuffers(1, &mVertexBuffer);
+	glDeleteBuffers(1, &mIndexBuffer);
+	glDeleteBuffers(1, &mInstanceBuffer);
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void TileInstanceBuffer::Upload()
+{
+	const size_t count = mInstances.size();
+	const TileInstance* instances = mInstances.data();
+
+	glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+	if (count > mCapacity)
+	{
+		glBufferData(GL_ARRAY_BUFFER, count * sizeof(TileInstance), instances, GL_DYNAMIC_DRAW);
+		mCapacity = count;
+	}
+	else if (count != 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(TileInstance), instances);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	mNumInstances = count;
+}
+
+void TileInstanceBuffer::Upload(size_t first, size_t count)
+{
+	if (count == 0 || first + count > mNumInstances) return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+	glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(TileInstance), count * sizeof(TileInstance),
+		mInstances.data() + first);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TileInstanceBuffer::Draw() const
+{
+	Draw(0, mNumInstances);
+}
+
+void TileInstanceBuffer::Draw(size_t first, size_t count) const
+{
+	if (count == 0 || first + count > mNumInstances) return;
+
+	glBindVertexArray(mVertexArray);
+	SetInstanceOffset(mInstanceBuffer, first);
+	glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(count));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
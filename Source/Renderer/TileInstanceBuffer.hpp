@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Sprite layer meaning "no tile"
+constexpr uint8_t NO_TILE = 0xFF;
+// Bits of TileInstance::mFlags
+constexpr uint8_t TILE_FLAG_CAPITAL = 1 << 0;
+
+// Per-tile data of the instanced map draw, read by the shader as uvec4 aTile
+struct TileInstance
+{
+	glm::vec2 mPosition;
+	uint8_t mBaseTile;
+	uint8_t mOverlayTile;
+	uint8_t mFlags;
+	uint8_t mPadding;
+};
+
+// Unit quad drawn once per TileInstance with a single glDrawElementsInstanced
+class TileInstanceBuffer
+{
+public:
+	TileInstanceBuffer();
+	~TileInstanceBuffer();
+
+	// CPU copy of the instances, filled by the map renderer
+	std::vector<TileInstance>& GetInstances() { return mInstances; }
+
+	// Copies the instances to the GPU, growing the buffer when needed
+	void Upload();
+	// Copies only the instances in [first, first + count), the buffer must already hold them all
+	void Upload(size_t first, size_t count);
+
+	// Draws every uploaded instance with the active shader
+	void Draw() const;
+	// Draws the instances in [first, first + count), the VAO stays bound for further ranges
+	void Draw(size_t first, size_t count) const;
+
+	size_t GetNumInstances() const { return mNumInstances; }
+
+private:
+	std::vector<TileInstance> mInstances;
+	size_t mNumInstances;
+	size_t mCapacity;
+	unsigned int mVertexBuffer;
+	unsigned int mIndexBuffer;
+	unsigned int mInstanceBuffer;
+	unsigned int mVertexArray;
+};
@@ -3,17 +3,12 @@
 #include "Characters.hpp"
 #include "imgui.h"
 #include "MapGenerator.hpp"
+#include "Queries.hpp"
 #include "Components/Province.hpp"
 
 ArmyModule::ArmyModule(const flecs::world& ecs)
 {
-    const auto qTopmostRealm = ecs.query_builder<>("TopmostRealm")
-        .without<InRealm>()
-        .with<InRealm>("$this").src("$province")
-        .build();
-    const auto qPlayerRealm = ecs.query_builder<>("PlayerRealm")
-        .with<RulerOf>("$this").src<Player>()
-        .build();
+    const auto qPlayerRealm = ecs.get<QueryRegistry>().qPlayerRealm;
 
     void(ecs.component<MovingArmies>().add(flecs::Singleton));
 
@@ -41,12 +36,12 @@ ArmyModule::ArmyModule(const flecs::world& ecs)
                     if (xd < 0 || xd >= map.width) continue;
                     if (yd < 0 || yd >= map.height) continue;
 
-                    flecs::entity pe = map.tiles[xd][yd];
+                    flecs::entity pe = map.At(xd, yd);
                     auto &p = pe.get_mut<Province>();
                     auto &a = pe.get_mut<ProvinceArmy>();
-                    const auto &top = qTopmostRealm.set_var("province", pe).first();
+                    const auto index = map.Index(xd, yd);
 
-                    bool isMove = playerRealm == top;
+                    bool isMove = playerRealm.id() == map.topmost[index];
                     std::string text = isMove ?
                         "Mover para " + p.name + "##" + std::to_string(pe.id()) :
                         "Atacar " + p.name + "##" + std::to_string(pe.id());
@@ -62,7 +57,7 @@ ArmyModule::ArmyModule(const flecs::world& ecs)
                             if (a.mAmount < movement.mAmount)
                             {
                                 a.mAmount = movement.mAmount - a.mAmount;
-                                void(pe.remove(ecs.component<InRealm>(), top));
+                                if (map.realm[index]) void(pe.remove<InRealm>(flecs::entity(ecs, map.realm[index])));
                                 void(pe.add<InRealm>(playerRealm));
                             } else
                             {
@@ -70,6 +65,8 @@ ArmyModule::ArmyModule(const flecs::world& ecs)
                                 // TODO: reduce relations
                             }
                         }
+                        e.modified<ProvinceArmy>();
+                        pe.modified<ProvinceArmy>();
                     }
                 }
             }
@@ -13,7 +13,6 @@
 #include "MapGenerator.hpp"
 
 #include "Components/Dynasty.hpp"
-// TODO: make random deterministic
 #include "GameTime.hpp"
 #include "Random.hpp"
 #include "UI/UIScreens/GameUIModule.hpp"
@@ -33,13 +32,13 @@ struct CharacterBuilder
     toml::node_view<toml::node> maleNames;
     toml::node_view<toml::node> femaleNames;
 
-    std::string GenProvinceName() const;
-    std::string GenDynastyName() const;
-    std::string GenMaleName() const;
-    std::string GenFemaleName() const;
-    CultureType GenCulture() const;
+    std::string GenProvinceName(RandomStream &rng) const;
+    std::string GenDynastyName(RandomStream &rng) const;
+    std::string GenMaleName(RandomStream &rng) const;
+    std::string GenFemaleName(RandomStream &rng) const;
+    CultureType GenCulture(RandomStream &rng) const;
 
-    EntityHandler CreateDynastyWithKingdomAndFamily(bool isPlayer = false) const;
+    EntityHandler CreateDynastyWithKingdomAndFamily(RandomStream &rng, bool isPlayer = false) const;
     flecs::entity CreateCharacter(
         const std::string& char_name,
         const flecs::entity& dynasty_entity,
@@ -93,41 +92,41 @@ flecs::entity CharacterBuilder::CreateCharacter(
 
 // TODO: cleanup the code below, because it's ugly
 
-std::string getRandomArrayElement(const toml::array *array)
+std::string getRandomArrayElement(const toml::array *array, RandomStream &rng)
 {
-    size_t index = Random::GetIntRange(0, array->size() - 1);
+    size_t index = rng.GetIntRange(0, array->size() - 1);
     return std::string(*array->get_as<std::string>(index));
 }
 
-std::string CharacterBuilder::GenProvinceName() const
+std::string CharacterBuilder::GenProvinceName(RandomStream &rng) const
 {
-    return getRandomArrayElement(provinceNames["prefixes"].as_array())
-        + getRandomArrayElement(provinceNames["suffixes"].as_array());
+    return getRandomArrayElement(provinceNames["prefixes"].as_array(), rng)
+        + getRandomArrayElement(provinceNames["suffixes"].as_array(), rng);
 }
 
-std::string CharacterBuilder::GenDynastyName() const
+std::string CharacterBuilder::GenDynastyName(RandomStream &rng) const
 {
-    return getRandomArrayElement(dynastyNames["prefixes"].as_array())
-        + getRandomArrayElement(dynastyNames["suffixes"].as_array());
+    return getRandomArrayElement(dynastyNames["prefixes"].as_array(), rng)
+        + getRandomArrayElement(dynastyNames["suffixes"].as_array(), rng);
 }
 
-std::string CharacterBuilder::GenMaleName() const
+std::string CharacterBuilder::GenMaleName(RandomStream &rng) const
 {
-    return getRandomArrayElement(maleNames["prefixes"].as_array())
-        + getRandomArrayElement(maleNames["infixes"].as_array())
-        + getRandomArrayElement(maleNames["suffixes"].as_array());
+    return getRandomArrayElement(maleNames["prefixes"].as_array(), rng)
+        + getRandomArrayElement(maleNames["infixes"].as_array(), rng)
+        + getRandomArrayElement(maleNames["suffixes"].as_array(), rng);
 }
 
-std::string CharacterBuilder::GenFemaleName() const
+std::string CharacterBuilder::GenFemaleName(RandomStream &rng) const
 {
-    return getRandomArrayElement(femaleNames["prefixes"].as_array())
-        + getRandomArrayElement(femaleNames["infixes"].as_array())
-        + getRandomArrayElement(femaleNames["suffixes"].as_array());
+    return getRandomArrayElement(femaleNames["prefixes"].as_array(), rng)
+        + getRandomArrayElement(femaleNames["infixes"].as_array(), rng)
+        + getRandomArrayElement(femaleNames["suffixes"].as_array(), rng);
 }
 
-CultureType CharacterBuilder::GenCulture() const
+CultureType CharacterBuilder::GenCulture(RandomStream &rng) const
 {
-    switch (Random::GetIntRange(1, 4)) {
+    switch (rng.GetIntRange(1, 4)) {
     case 0:
         return SteppeNomads;
     case 1:
@@ -139,33 +138,33 @@ CultureType CharacterBuilder::GenCulture() const
     }
 }
 
-EntityHandler CharacterBuilder::CreateDynastyWithKingdomAndFamily(bool isPlayer) const
+EntityHandler CharacterBuilder::CreateDynastyWithKingdomAndFamily(RandomStream &rng, bool isPlayer) const
 {
-    auto dName = GenDynastyName();
+    auto dName = GenDynastyName(rng);
 
     auto dynasty = ecs.entity().set<Dynasty>({ dName });
 
     auto kingdom = ecs.entity().set<Title>({
         .name = dName + " Kingdom",
-        .color = glm::vec3(Random::GetFloat(), Random::GetFloat(), Random::GetFloat()),
+        .color = rng.GetVector(glm::vec3(0.0f), glm::vec3(1.0f)),
     });
-    auto culture = GenCulture();
+    auto culture = GenCulture(rng);
 
     void(dynasty.set<CharacterCulture>(CharacterCulture { culture }));
 
 
-    auto rulerName = GenMaleName();
+    auto rulerName = GenMaleName(rng);
     auto ruler = CreateCharacter(rulerName, dynasty, true, isPlayer ? ecs.entity<Player>() : ecs.entity(), culture)
         .add<DynastyHead>(dynasty).add<CharacterCulture>(culture);
     void(kingdom.add<RuledBy>(ruler));
 
     void(ruler.add<RulerOf>(kingdom));
 
-    auto spouseName = GenFemaleName();
+    auto spouseName = GenFemaleName(rng);
     auto spouse = CreateCharacter(spouseName, dynasty, false, culture)
         .add<MarriedTo>(ruler)
         .add<DynastyMember>(dynasty)
-        .add<CharacterCulture>(GenCulture());
+        .add<CharacterCulture>(GenCulture(rng));
     void(ruler.add<MarriedTo>(spouse));
 
     return EntityHandler {
@@ -235,6 +234,8 @@ CharactersModule::CharactersModule(const flecs::world& ecs)
             .build(),
     };
 
+    if (ecs.has<Headless>()) return;
+
     ecs.system<>()
         .tick_source(tickTimer)
         .run([queries](const flecs::iter &it)
@@ -246,29 +247,10 @@ CharactersModule::CharactersModule(const flecs::world& ecs)
 
 void CreateKingdoms(const flecs::world &ecs)
 {
-    // Local structure for the priority queue in the Dijkstra-like algorithm
-    struct ProvinceDistance
-    {
-        flecs::entity province_entity;
-        float distance; // Accumulated distance from the seed
-
-        // Min-heap ordering (std::priority_queue is max-heap by default, so use operator>)
-        bool operator>(const ProvinceDistance& other) const
-        {
-            return distance > other.distance;
-        }
-    };
-
-    struct EntityHash {
-        size_t operator()(const flecs::entity& e) const {
-            // Use the underlying ID of the entity for hashing.
-            return std::hash<uint64_t>{}(e.id());
-        }
-    };
-
-    // Map to hold all unruled, non-sea provinces still available for a new kingdom seed
-    std::unordered_map<flecs::entity, bool, EntityHash> available_provinces;
-    std::unordered_map<flecs::entity, float, EntityHash> current_expansion_distance;
+    // Owner of tiles which can't be claimed (sea or already ruled) and of tiles still available
+    constexpr int UNCLAIMABLE = -2;
+    constexpr int AVAILABLE = -1;
+    constexpr size_t NOT_IN_POOL = std::numeric_limits<size_t>::max();
 
     // --- 1. Identify all initial unruled, non-sea provinces ---
 
@@ -277,22 +259,39 @@ void CreateKingdoms(const flecs::world &ecs)
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "CreateKingdoms: TileMap entity not found. Cannot generate kingdoms.");
         return;
     }
-    const TileMap* tilemap = &tilemap_entity.get<TileMap>();
+    const TileMap* tilemap = tilemap_entity.try_get<TileMap>();
     if (!tilemap) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "CreateKingdoms: TileMap component not found. Cannot generate kingdoms.");
         return;
     }
 
-    // Query all province entities to build the initial available pool
-    ecs.each<const Province>([&](const flecs::entity p_entity, const Province& p) {
+    // Per tile state, indexed like the TileMap columns
+    const size_t tile_count = tilemap->tiles.size();
+    std::vector<int> owner(tile_count, UNCLAIMABLE);
+    std::vector<uint32_t> expansion_distance(tile_count, NO_PATH);
+
+    // Pool of the provinces still available for a new kingdom seed, with constant time removal
+    std::vector<size_t> available_provinces;
+    std::vector<size_t> pool_slot(tile_count, NOT_IN_POOL);
+    auto claim = [&](size_t tile, int kingdom) {
+        owner[tile] = kingdom;
+        const size_t slot = pool_slot[tile];
+        available_provinces[slot] = available_provinces.back();
+        pool_slot[available_provinces[slot]] = slot;
+        available_provinces.pop_back();
+        pool_slot[tile] = NOT_IN_POOL;
+    };
+
+    for (size_t i = 0; i < tile_count; ++i) {
         // Check 1: Is it a non-sea tile?
-        if (p.terrain != TerrainType::Sea) {
-            // Check 2: Is it unruled? (Check for the target of the RuledBy relationship)
-            if (!p_entity.target<RuledBy>().is_valid()) {
-                available_provinces[p_entity] = true;
-            }
-        }
-    });
+        if (tilemap->terrain[i] == TerrainType::Sea) continue;
+        // Check 2: Is it unruled? (Check for the target of the RuledBy relationship)
+        if (tilemap->tiles[i].target<RuledBy>().is_valid()) continue;
+
+        owner[i] = AVAILABLE;
+        pool_slot[i] = available_provinces.size();
+        available_provinces.push_back(i);
+    }
 
     if (available_provinces.empty()) {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "No available non-sea provinces to form kingdoms.");
@@ -300,182 +299,110 @@ void CreateKingdoms(const flecs::world &ecs)
     }
 
     const auto& builder = ecs.get<CharacterBuilder>();
+    RandomStream rng(RandomSubsystem::WorldGen, 0, 0);
     int kingdom_index = 0;
 
+    // Reused by every kingdom
+    std::vector<size_t> newly_claimed_provinces;
+    BucketQueue queue;
+
     // --- 2. Kingdom Generation Loop ---
     while (!available_provinces.empty())
     {
+        const int kingdom = kingdom_index;
+
         // A. Create New Kingdom (Dynasty/Title)
-        auto handler = builder.CreateDynastyWithKingdomAndFamily(kingdom_index++ == 0);
+        auto handler = builder.CreateDynastyWithKingdomAndFamily(rng, kingdom_index++ == 0);
 
-        auto kingdom_dynasty = handler.dynasty;
         auto kingdom_title = handler.kingdom;
-        auto kingdom_ruler = handler.ruler;
         auto culture = handler.culture;
 
-
         // B. Select Random Seed Province (Initial Capital)
-        std::vector<flecs::entity> current_unruled_provinces;
-        for (const auto&[fst, snd] : available_provinces) {
-            if (snd) { // Only pick truly available provinces
-                current_unruled_provinces.push_back(fst);
-            }
-        }
-
-        if (current_unruled_provinces.empty()) {
-            break; // No more provinces available
-        }
+        const size_t seed_province = available_provinces[rng.GetIntRange(0, available_provinces.size() - 1)];
 
-        flecs::entity seed_province_entity = current_unruled_provinces[Random::GetIntRange(0, current_unruled_provinces.size() - 1)];
-
-        // Temporary maps and queue for the current kingdom's expansion
-        std::vector<flecs::entity> newly_claimed_provinces;
-        std::priority_queue<ProvinceDistance, std::vector<ProvinceDistance>, std::greater<ProvinceDistance>> pq;
+        newly_claimed_provinces.clear();
 
         // 1. Initialize Seed
-        pq.push({seed_province_entity, 0.0f});
-        current_expansion_distance[seed_province_entity] = 0.0f;
+        queue.Clear();
+        queue.Push(0, static_cast<uint32_t>(seed_province));
+        expansion_distance[seed_province] = 0;
 
         // Claim seed province
-        available_provinces[seed_province_entity] = false; // Mark as no longer available in the pool
-        newly_claimed_provinces.push_back(seed_province_entity);
-
-        // 2. Expansion Loop (Dijkstra-like)
-        while (!pq.empty())
-        {
-            ProvinceDistance current = pq.top();
-            pq.pop();
+        claim(seed_province, kingdom);
+        newly_claimed_provinces.push_back(seed_province);
 
-            flecs::entity current_entity = current.province_entity;
-            float current_dist = current.distance;
-
-            // Get current tile data
-            const TileData* current_tile_data = &current_entity.get<TileData>();
-            const Province* current_province = &current_entity.get<Province>();
-
-            if (!current_tile_data || !current_province) continue;
-
-            // Cost to move *from* the current tile to a neighbor
-            float travel_cost = current_province->movement_cost;
-
-            // Iterate through 4 cardinal directions
-            const int dx[] = {0, 0, 1, -1};
-            const int dy[] = {1, -1, 0, 0};
-
-            for (int i = 0; i < 4; ++i)
+        // 2. Expansion Loop (Dijkstra-like), stopping at a distance of 100
+        ExpandGrid(queue, tilemap->width, tilemap->height, expansion_distance.data(),
+            [&](uint32_t current, uint32_t neighbor) -> uint32_t
             {
-                int nx = current_tile_data->x + dx[i];
-                int ny = current_tile_data->y + dy[i];
-
-                // Check bounds
-                if (nx < 0 || nx >= MAP_WIDTH || ny < 0 || ny >= MAP_HEIGHT) {
-                    continue;
-                }
-
-                flecs::entity neighbor_entity = tilemap->tiles[nx][ny];
-                if (!neighbor_entity.is_valid()) continue;
-
-                const Province* neighbor_province = &neighbor_entity.get<Province>();
-                if (!neighbor_province) continue;
-
                 // Ignore sea tiles
-                if (neighbor_province->terrain == TerrainType::Sea) {
-                    continue;
-                }
-
-                // Calculate new distance using the current tile's movement cost
-                float new_dist = current_dist + travel_cost;
-
-                // Stop condition: distance > 100
-                if (new_dist > 100.0f) {
-                    continue;
-                }
-
-                // Check if the tile is unruled (available)
-                bool is_available = available_provinces.count(neighbor_entity) && available_provinces.at(neighbor_entity);
-                // Check if the tile is already claimed by this kingdom (i.e., in the newly_claimed list)
-                bool is_claimed_by_self = std::find(newly_claimed_provinces.begin(), newly_claimed_provinces.end(), neighbor_entity) != newly_claimed_provinces.end();
-
-                // Get the old distance (or infinity if not yet reached)
-                float old_dist = current_expansion_distance.count(neighbor_entity)
-                               ? current_expansion_distance.at(neighbor_entity)
-                               : std::numeric_limits<float>::infinity();
-
-                if (is_available || is_claimed_by_self)
-                {
-                    if (new_dist < old_dist)
-                    {
-                        // Found a shorter path
-                        current_expansion_distance[neighbor_entity] = new_dist;
-
-                        // Claim it if it was available (only claims unruled tiles)
-                        if (is_available) {
-                            available_provinces[neighbor_entity] = false; // Mark as no longer available
-                            newly_claimed_provinces.push_back(neighbor_entity);
-                            neighbor_entity.add<RuledBy>(kingdom_title); // Assign ownership
-                        }
-                        // Push to queue for further expansion
-                        pq.push({neighbor_entity, new_dist});
-                    }
-                }
-            }
-        }
+                if (tilemap->terrain[neighbor] == TerrainType::Sea) return NO_PATH;
+                // Only unruled tiles or tiles already claimed by this kingdom are expanded
+                if (owner[neighbor] != AVAILABLE && owner[neighbor] != kingdom) return NO_PATH;
+                // Cost to move *from* the current tile to a neighbor
+                return StepCost(tilemap->movement_cost[current]);
+            },
+            [&](uint32_t, uint32_t neighbor)
+            {
+                // Claim it if it was available (only claims unruled tiles)
+                if (owner[neighbor] != AVAILABLE) return;
+                claim(neighbor, kingdom);
+                newly_claimed_provinces.push_back(neighbor);
+                void(tilemap->tiles[neighbor].add<RuledBy>(kingdom_title)); // Assign ownership
+            },
+            100);
 
         // D. Select Capital (Most Central Province: minimum distance from the initial seed)
-        flecs::entity capital_province_entity = flecs::entity::null();
-        float min_dist = std::numeric_limits<float>::max();
+        size_t capital_province = NOT_IN_POOL;
+        uint32_t min_dist = NO_PATH;
 
-        for (flecs::entity p_entity : newly_claimed_provinces)
+        for (const size_t p_tile : newly_claimed_provinces)
         {
-            if (current_expansion_distance.count(p_entity))
+            if (expansion_distance[p_tile] < min_dist)
             {
-                float dist = current_expansion_distance.at(p_entity);
-                if (dist < min_dist)
-                {
-                    min_dist = dist;
-                    capital_province_entity = p_entity;
-                }
+                min_dist = expansion_distance[p_tile];
+                capital_province = p_tile;
             }
         }
 
         // E. Set Capital Relation and Update Province Distances
-        if (capital_province_entity.is_valid())
+        if (capital_province != NOT_IN_POOL)
         {
             // Set the capital relationship: Province has (CapitalOf, KingdomTitleEntity)
-            capital_province_entity.add<CapitalOf>(kingdom_title);
-
+            void(tilemap->tiles[capital_province].add<CapitalOf>(kingdom_title));
 
             // Update distance_to_capital for all provinces in the realm
-            for (flecs::entity p_entity : newly_claimed_provinces)
+            for (const size_t p_tile : newly_claimed_provinces)
             {
+                flecs::entity p_entity = tilemap->tiles[p_tile];
                 if (Province* p = p_entity.try_get_mut<Province>())
                 {
                     // Store the shortest distance from the most central seed as distance_to_capital
-                    p->distance_to_capital = current_expansion_distance.count(p_entity)
-                                            ? current_expansion_distance.at(p_entity)
-                                            : std::numeric_limits<float>::infinity();
+                    p->distance_to_capital = static_cast<float>(expansion_distance[p_tile]);
 
                     auto traits = GetCulturalTraits(p->culture);
 
-                    p->name = builder.GenProvinceName();
+                    p->name = builder.GenProvinceName(rng);
 
                     p->popular_opinion = culture == p->culture ? 10 : -10;
                     p->control = 80 +
                         p->popular_opinion -
                         p->distance_to_capital * 0.2f +
                         10 * GetCulturalTraits(culture).extra_control;
-                    p->development = Random::GetIntRange(3, 15) + 5 * traits.extra_development;
+                    p->development = rng.GetIntRange(3, 15) + 5 * traits.extra_development;
 
                     p->income = 5 * (100 + p->development) * p->control * 0.01f;
 
                     void(p_entity.add<InRealm>(kingdom_title));
                 }
             }
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Kingdom %d formed with %zu provinces. Capital set.", kingdom_index, newly_claimed_provinces.size());
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Kingdom %d formed with %zu provinces. Capital set.", kingdom_index, newly_claimed_provinces.size());
         } else {
              SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Kingdom %d generated no provinces. This should not happen if a seed was available.", kingdom_index);
         }
     }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%d kingdoms formed.", kingdom_index);
 }
 
 // 1. Renders the main window listing all rulers.
@@ -670,12 +597,13 @@ void RenderCharacterDetailWindow(
     ImGui::End();
 }
 
-flecs::entity BirthChildCharacter(const flecs::world& ecs, const Character& father, const Character& mother, flecs::entity dynasty)
+flecs::entity BirthChildCharacter(const flecs::world& ecs, const Character& father, const Character& mother, flecs::entity dynasty,
+                                  RandomStream &rng)
 {
     const auto oldScope = ecs.set_scope(ecs.entity("Kingdoms"));
     const auto &builder = ecs.get<CharacterBuilder>();
-    bool isMale = Random::GetIntRange(0, 1);
-    auto name = isMale ? builder.GenMaleName() : builder.GenFemaleName();
+    bool isMale = rng.GetIntRange(0, 1);
+    auto name = isMale ? builder.GenMaleName(rng) : builder.GenFemaleName(rng);
     auto child = builder.CreateCharacter(name, dynasty, isMale,dynasty.get<CharacterCulture>().culture, 0);
     void(ecs.set_scope(oldScope));
 
@@ -6,6 +6,8 @@
 #include "Components/Province.hpp"
 #include "Components/Culture.hpp"
 
+class RandomStream;
+
 struct Title
 {
     std::string name;
@@ -95,4 +97,4 @@ void RenderCharacterDetailWindow(
     flecs::entity titleEntity, const Character& c, const CharacterQueries& queries);
 
 flecs::entity BirthChildCharacter(const flecs::world& ecs, const Character& father, const Character& mother,
-                                  flecs::entity dynasty);
\ No newline at end of file
+                                  flecs::entity dynasty, RandomStream &rng);
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "DecisionPolicy.hpp"
+
+#include <algorithm>
+
+#include "Random.hpp"
+
+size_t DecisionPolicy::Choose(const DecisionKind kind, const flecs::entity event, const size_t numChoices) const
+{
+    if (numChoices == 0 || !mChoose) return 0;
+    return std::min(mChoose(kind, event, numChoices), numChoices - 1);
+}
+
+DecisionPolicy DecisionPolicy::FirstChoice()
+{
+    return { [](DecisionKind, flecs::entity, size_t) -> size_t { return 0; } };
+}
+
+DecisionPolicy DecisionPolicy::RandomChoice()
+{
+    return { [](DecisionKind kind, const flecs::entity event, const size_t numChoices) -> size_t
+    {
+        RandomStream rng(RandomSubsystem::Decisions, event.id(), static_cast<uint64_t>(kind));
+        return rng.GetIntRange(0, static_cast<int>(numChoices) - 1);
+    } };
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <flecs.h>
+
+// Kinds of choices that the game would otherwise ask the player through the UI
+enum class DecisionKind
+{
+    EstatePower,
+    Diplomacy,
+};
+
+// Resolves event choices without a UI (used by the headless simulation)
+struct DecisionPolicy
+{
+    // Returns the index of the chosen option, in [0, numChoices)
+    std::function<size_t(DecisionKind kind, flecs::entity event, size_t numChoices)> mChoose;
+
+    [[nodiscard]] size_t Choose(DecisionKind kind, flecs::entity event, size_t numChoices) const;
+
+    // Always picks the first option
+    static DecisionPolicy FirstChoice();
+    // Picks any option with the same probability
+    static DecisionPolicy RandomChoice();
+};
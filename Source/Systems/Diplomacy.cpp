@@ -7,6 +7,7 @@
 #include <regex>
 
 #include "Characters.hpp"
+#include "DecisionPolicy.hpp"
 #include "Events.hpp"
 #include "Game.hpp"
 #include "imgui.h"
@@ -24,49 +25,23 @@ std::string applySubstitutions(std::string text, const Title &kingdom, const Tit
     return text;
 }
 
+void ApplyDiploEventChoice(const DiploEvent &event, const DiploEventChoice &choice)
+{
+    auto &relation = event.mSourceRealm.ensure<RealmRelation>(event.mTargetRealm);
+    relation.relations = std::clamp<int>((int)relation.relations + choice.mRelationChange, -128, 127);
+    // Lets the diplomatic map mode notice the change
+    event.mSourceRealm.modified<RealmRelation>(event.mTargetRealm);
+}
+
 DiplomacyModule::DiplomacyModule(const flecs::world& ecs)
 {
     const auto &timers = ecs.get<GameTickSources>();
 
     void(ecs.component<RealmRelation>().add(flecs::Symmetric));
+    // Added and removed by the ProvinceUpdates observers as realms gain and lose shared borders,
+    // must be symmetric before the first kingdom is created
     void(ecs.component<Neighboring>().add(flecs::Symmetric));
 
-    const auto topmostRealm = ecs.query_builder<const Title>("GetTopmostRealm")
-        .with<InRealm>("$this").src("$province")
-        .without<InRealm>(flecs::Wildcard)
-        .build();
-
-    void(ecs.system<const Province, const TileMap>("UpdateNeighbors")
-        .term_at(0).src("$province")
-        .with<InRealm>("$realm").src("$province")
-        .with<RulerOf>("$realm").src("$player")
-        .with<Player>().src("$player")
-        .write<Neighboring>()
-        .tick_source(timers.mWeekTimer)
-        .run([=](flecs::iter &it)
-        {
-            ecs.remove_all<Neighboring>();
-            while (it.next())
-            {
-                const auto &provinces = it.field<const Province>(0);
-                auto &tileMap = it.field_at<const TileMap>(1, 0);
-                for (const size_t i: it)
-                {
-                    const auto &province = provinces[i];
-                    const auto r0 = it.get_var("realm");
-                    {
-                        const size_t i = province.mPosX, j = province.mPosY;
-                        const auto r1 = topmostRealm.set_var("province", tileMap.tiles[i + 1][j]).first();
-                        const auto r2 = topmostRealm.set_var("province", tileMap.tiles[i + 1][j + 1]).first();
-                        const auto r3 = topmostRealm.set_var("province", tileMap.tiles[i][j + 1]).first();
-                        if (r1.is_valid() && r1 != r0) void(r0.add<Neighboring>(r1));
-                        if (r2.is_valid() && r2 != r0) void(r0.add<Neighboring>(r2));
-                        if (r3.is_valid() && r3 != r0) void(r0.add<Neighboring>(r3));
-                    }
-                }
-            }
-        }));
-
     const auto path = std::filesystem::path(SDL_GetBasePath()) / "Assets" / "DiploEvents.toml";
     static toml::table eventsTbl = toml::parse_file(path.string());
 
@@ -80,12 +55,16 @@ DiplomacyModule::DiplomacyModule(const flecs::world& ecs)
         .with<Neighboring>("$neighbor").src("$realm")
         .with<RulerOf>("$neighbor").src("$neighborRuler")
         .write<RealmRelation>()
+        .kind<SimulationStep>()
         .tick_source(timers.mMonthTimer)
         .each([=](flecs::iter &it, size_t, const Title &a, const Title &b, const Character &ar, const Character &br, const GameTime &gameTime)
         {
-            if (Random::GetFloat() >= 0.2f) return;
+            // One stream for each pair of neighbouring realms
+            RandomStream rng(RandomSubsystem::Diplomacy, ecs_pair(it.get_var("realm").id(), it.get_var("neighbor").id()),
+                             gameTime.TimeDays());
+            if (rng.GetFloat() >= 0.2f) return;
             const auto *eventsArray = eventsTbl["event"].as_array();
-            size_t idx = Random::GetIntRange(0, eventsArray->size() - 1);
+            size_t idx = rng.GetIntRange(0, eventsArray->size() - 1);
             const auto &tbl = *eventsArray->get_as<toml::table>(idx);
             std::vector<DiploEventChoice> choices;
             tbl["option"].as_array()->for_each([&](const toml::table &t)
@@ -104,9 +83,25 @@ DiplomacyModule::DiplomacyModule(const flecs::world& ecs)
                     .mSourceRealm = it.get_var("realm"),
                     .mTargetRealm = it.get_var("neighbor")
                 })
-                .set(EventSchedule::InXDays(gameTime, Random::GetIntRange(0, 30)));
+                .set(EventSchedule::InXDays(gameTime, rng.GetIntRange(0, 30)));
         }));
 
+    if (ecs.has<Headless>())
+    {
+        ecs.system<const DiploEvent, const DecisionPolicy>("ResolveDiploEvents")
+            .with<FiredEvent>()
+            .each([](flecs::entity entity, const DiploEvent &event, const DecisionPolicy &policy)
+            {
+                if (!event.mChoices.empty())
+                {
+                    const size_t choice = policy.Choose(DecisionKind::Diplomacy, entity, event.mChoices.size());
+                    ApplyDiploEventChoice(event, event.mChoices[choice]);
+                }
+                entity.destruct();
+            });
+        return;
+    }
+
     ecs.system<const DiploEvent>("RenderDiploEvents")
         .with<FiredEvent>()
         .each([](flecs::entity entity, const DiploEvent &event)
@@ -120,8 +115,7 @@ DiplomacyModule::DiplomacyModule(const flecs::world& ecs)
                 {
                     if (ImGui::Button(choice.mText.data()))
                     {
-                        auto &relation = event.mSourceRealm.ensure<RealmRelation>(event.mTargetRealm);
-                        relation.relations = std::clamp<int>((int)relation.relations + choice.mRelationChange, -128, 127);
+                        ApplyDiploEventChoice(event, choice);
                         entity.destruct();
                     }
                     if (ImGui::BeginItemTooltip())
@@ -32,4 +32,8 @@ struct DiploEvent
     flecs::entity mTargetRealm;
 };
 
+// Between two topmost realms sharing at least one tile border, see TileMap::adjacency for the lengths
 struct Neighboring {};
+
+// Applies the relation change of a choice between the event's realms
+void ApplyDiploEventChoice(const DiploEvent &event, const DiploEventChoice &choice);
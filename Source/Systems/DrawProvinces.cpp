@@ -1,6 +1,7 @@
 #include "DrawProvinces.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <SDL3/SDL.h>
 #include <GL/glew.h>
 #include <flecs.h>
@@ -15,230 +16,225 @@
 #include "Components/Province.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Renderer/Shader.hpp"
+#include "Renderer/TileInstanceBuffer.hpp"
+#include "Renderer/ProvinceMapTextures.hpp"
+#include "Renderer/GpuTimer.hpp"
+#include "Renderer/TextureArray.hpp"
+#include "Renderer/PrimitiveBatch.hpp"
+#include "Renderer/BorderMesh.hpp"
+#include "MapGenerator.hpp"
+#include "Queries.hpp"
 
 constexpr float TILE_SIZE_WORLD = 32.0f;
-glm::vec3 CultureColor(CultureType culture)
+constexpr int TILE_SPRITE_SIZE = 32;
+// Layer of the capital marker in the tile sprite array
+constexpr int CAPITAL_LAYER = 0;
+
+// Tiles seen by the camera as (first x, first y, last x, last y), empty when last < first.
+// Tile (x, y) covers the world square of side TILE_SIZE_WORLD centered at (x, y) * TILE_SIZE_WORLD.
+glm::ivec4 VisibleTileRect(const TileMap &tileMap, const Camera &camera, const Window &window)
 {
-    switch (culture)
-    {
-    case SteppeNomads:
-        return {0.7f, 0.6f, 0.4f};
-    case FarmLanders:
-        return {0.4f, 0.8f, 0.3f};
-    case ForestFolk:
-        return {0.1f, 0.4f, 0.15f};
-    case HillDwellers:
-        return {0.5f, 0.5f, 0.55f};
-    default:
-        return {0.0f, 0.0f, 0.0f};
-    }
+    const glm::vec4 rect = camera.GetVisibleRect(window) / TILE_SIZE_WORLD + 0.5f;
+    return {
+        std::max(0, static_cast<int>(std::floor(rect.x))),
+        std::max(0, static_cast<int>(std::floor(rect.y))),
+        std::min(tileMap.width - 1, static_cast<int>(std::floor(rect.z))),
+        std::min(tileMap.height - 1, static_cast<int>(std::floor(rect.w))),
+    };
 }
 
-void renderPoliticalMap(flecs::iter &it)
+// Copies the dirty tiles of the TileMap to the province texture, or the whole map when most of it changed
+void UploadProvinceData(const TileMap &tileMap, ProvinceMapTextures &textures)
 {
-    while (it.next())
+    const auto texel = [&](size_t i)
     {
-        const auto &renderer = it.field_at<const Renderer>(2, 0);
-        const auto &camera = it.field_at<const Camera>(3, 0);
-        const auto &window = it.field_at<const Window>(4, 0);
-
-        const auto &shader = renderer.mPoliticalShader;
-        const auto &verts = renderer.mSpriteVerts;
-        shader->SetActive();
-        verts->SetActive();
-
-        const auto &provinces = it.field<const Province>(0);
-        const auto &title = it.field_at<const Title>(1, 0);
-
-        for (size_t i: it)
-        {
-            const auto &province = provinces[i];
-            glm::mat4 model = glm::translate(
-                            glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f) * TILE_SIZE_WORLD),
-                            glm::vec3(province.mPosX, province.mPosY, 0.0f));
-
-            shader->SetMatrixUniform("uView", camera.mView);
-            shader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
-            shader->SetMatrixUniform("uModel", model);
-            shader->SetVectorUniform("uRealmColor", glm::vec4(title.color, 1.0));
-            shader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
-
-            glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
-        }
+        return ProvinceMapTextures::TileTexel{
+            .mRealmSlot = textures.GetRealmSlot(tileMap.topmost[i]),
+            .mCulture = static_cast<uint16_t>(tileMap.culture[i]),
+            .mArmy = static_cast<uint16_t>(std::min<uint32_t>(tileMap.army[i], 0xFFFF)),
+            .mFlags = 0,
+        };
+    };
+
+    const bool resized = textures.Resize(tileMap.width, tileMap.height);
+    if (resized || tileMap.dirty.size() * 8 > tileMap.tiles.size())
+    {
+        std::vector<ProvinceMapTextures::TileTexel> texels(tileMap.tiles.size());
+        for (size_t i = 0; i < texels.size(); ++i)
+            texels[i] = texel(i);
+        textures.SetTiles(texels);
+    }
+    else
+    {
+        for (const uint32_t i : tileMap.dirty)
+            textures.SetTile(static_cast<int>(i % tileMap.width), static_cast<int>(i / tileMap.width), texel(i));
     }
 }
 
-void renderCultureMap(flecs::iter &it)
+// One texel per realm slot: the realm color and its relation with the player, or a negative relation
+// for destroyed realms, whose tiles are left to the geographic map. Tiles are keyed by their topmost
+// realm, so a vassal's provinces take the colors of its liege.
+void UploadRealmPalette(const flecs::world &ecs, ProvinceMapTextures &textures, flecs::entity playerRealm)
 {
-    while (it.next())
+    const auto &realms = textures.GetSlotRealms();
+    auto &palette = textures.GetPalette();
+    palette.assign(realms.size(), glm::vec4(0.0f, 0.0f, 0.0f, -1.0f));
+    for (size_t slot = 0; slot < realms.size(); ++slot)
     {
-        const auto &renderer = it.field_at<const Renderer>(2, 0);
-        const auto &camera = it.field_at<const Camera>(3, 0);
-        const auto &window = it.field_at<const Window>(4, 0);
+        if (!ecs.is_alive(realms[slot])) continue;
 
-        const auto &shader = renderer.mPoliticalShader;
-        const auto &verts = renderer.mSpriteVerts;
-        shader->SetActive();
-        verts->SetActive();
+        const flecs::entity realm = ecs.entity(realms[slot]);
+        const auto *title = realm.try_get<Title>();
+        if (!title) continue;
 
-        const auto &provinces = it.field<const Province>(0);
-        for (size_t i: it)
-        {
-            const auto &province = provinces[i];
-            glm::mat4 model = glm::translate(
-                            glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f) * TILE_SIZE_WORLD),
-                            glm::vec3(province.mPosX, province.mPosY, 0.0f));
-
-            shader->SetMatrixUniform("uView", camera.mView);
-            shader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
-            shader->SetMatrixUniform("uModel", model);
-            shader->SetVectorUniform("uRealmColor", glm::vec4(CultureColor(province.culture), 1.0));
-            shader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
-
-            glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
-        }
+        const auto *relation = playerRealm ? playerRealm.try_get<RealmRelation>(realm) : nullptr;
+        float relationF = relation ? (float(relation->relations) / 256.0f + 0.5f) : 0.5f;
+        if (realm == playerRealm) relationF = 1.0f;
+
+        palette[slot] = glm::vec4(title->color, relationF);
     }
+    textures.UploadPalette(playerRealm.id());
 }
 
-void renderDiplomacyMap(flecs::iter &it, flecs::entity playerRealm)
+// Draws the province based map modes as a single quad over the visible tiles
+void RenderMapMode(const Renderer &renderer, MapMode mode, const glm::ivec4 &visible)
 {
-    while (it.next())
-    {
-        const auto &renderer = it.field_at<const Renderer>(2, 0);
-        const auto &camera = it.field_at<const Camera>(3, 0);
-        const auto &window = it.field_at<const Window>(4, 0);
+    if (visible.z < visible.x || visible.w < visible.y) return;
 
-        const auto &shader = renderer.mHeatMapShader;
-        const auto &verts = renderer.mSpriteVerts;
-        shader->SetActive();
-        verts->SetActive();
+    const auto &shader = renderer.mProvinceMapShader;
+    const auto &verts = renderer.mSpriteVerts;
+    shader->SetActive();
+    verts->SetActive();
 
-        const auto &provinces = it.field<const Province>(0);
-        for (size_t i: it)
-        {
-            const auto &province = provinces[i];
-            const auto &relation = playerRealm.try_get<RealmRelation>(it.get_var("title"));
+    renderer.mProvinceMap->SetActive(1, 2);
+    shader->SetIntegerUniform("uProvinceData", 1);
+    shader->SetIntegerUniform("uRealmPalette", 2);
+    shader->SetIntegerUniform("uMapMode", static_cast<int>(mode));
+    shader->SetVectorUniform("uTileRect", glm::vec4(visible));
 
-            float relationF = relation ? (float(relation->relations) / 256.0f + 0.5f) : 0.5f;
-            if (it.get_var("title") == playerRealm) relationF = 1.0f;
+    glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
 
-            glm::mat4 model = glm::translate(
-                            glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f) * TILE_SIZE_WORLD),
-                            glm::vec3(province.mPosX, province.mPosY, 0.0f));
+    // Unbind
+    glBindVertexArray(0);
+}
 
-            shader->SetMatrixUniform("uView", camera.mView);
-            shader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
-            shader->SetMatrixUniform("uModel", model);
-            shader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
-            shader->SetVectorUniform("uMinColor", glm::vec4(1.0, 0.0, 0.0, 1.0));
-            shader->SetVectorUniform("uMaxColor", glm::vec4(0.0, 1.0, 0.0, 1.0));
-            shader->SetFloatUniform("uPercent", relationF);
+// Rebuilds the border slots of the 3x3 neighbourhood of every dirty tile, or of the whole map when
+// most of it changed. A tile owns its east and north edges, shown when the neighbour across them
+// belongs to another topmost realm.
+void UpdateRealmBorders(const TileMap &tileMap, BorderMesh &borders)
+{
+    const auto &topmost = tileMap.topmost;
+    const glm::vec4 borderColor(0.05f, 0.05f, 0.05f, 0.9f);
 
-            glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
+    const auto setEdges = [&](int x, int y)
+    {
+        const flecs::entity_t realm = topmost[tileMap.Index(x, y)];
+        const bool east = x + 1 < tileMap.width && topmost[tileMap.Index(x + 1, y)] != realm;
+        const bool north = y + 1 < tileMap.height && topmost[tileMap.Index(x, y + 1)] != realm;
+        borders.SetTileEdges(x, y, east, north, borderColor);
+    };
+
+    const bool resized = borders.Resize(tileMap.width, tileMap.height, TILE_SIZE_WORLD);
+    if (resized || tileMap.dirty.size() * 8 > tileMap.tiles.size())
+    {
+        for (int y = 0; y < tileMap.height; ++y)
+            for (int x = 0; x < tileMap.width; ++x)
+                setEdges(x, y);
+    }
+    else
+    {
+        for (const uint32_t i : tileMap.dirty)
+        {
+            const int x = static_cast<int>(i % tileMap.width), y = static_cast<int>(i / tileMap.width);
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                    if (tileMap.Contains(x + dx, y + dy))
+                        setEdges(x + dx, y + dy);
         }
     }
+    borders.Upload();
 }
 
-void renderArmyMap(flecs::iter &it)
+// Layers of the tile sprite array
+uint8_t BiomeTileIndex(BiomeType biome)
 {
-    while (it.next())
+    switch (biome)
     {
-        const auto &renderer = it.field_at<const Renderer>(2, 0);
-        const auto &camera = it.field_at<const Camera>(3, 0);
-        const auto &window = it.field_at<const Window>(4, 0);
-
-        const auto &shader = renderer.mHeatMapShader;
-        const auto &verts = renderer.mSpriteVerts;
-        shader->SetActive();
-        verts->SetActive();
-
-        const auto &provinces = it.field<const Province>(0);
-        for (size_t i: it)
-        {
-            const auto &province = provinces[i];
-            const auto &army = it.entity(i).get<ProvinceArmy>();
-
-            glm::mat4 model = glm::translate(
-                            glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f) * TILE_SIZE_WORLD),
-                            glm::vec3(province.mPosX, province.mPosY, 0.0f));
-
-            shader->SetMatrixUniform("uView", camera.mView);
-            shader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
-            shader->SetMatrixUniform("uModel", model);
-            shader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
-            shader->SetVectorUniform("uMinColor", glm::vec4(0.0, 0.0, 0.0, 1.0));
-            shader->SetVectorUniform("uMaxColor", glm::vec4(1.0, 0.0, 0.0, 1.0));
-            shader->SetFloatUniform("uPercent", std::clamp<float>(army.mAmount / 100.0f, 0.0, 1.0));
-
-            glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
-        }
+        case Water: return 10;
+        case Drylands: return 1;
+        case Grasslands: return 3;
+        case Jungles: return 5;
+        case Forests: return 2;
     }
+    return 0;
 }
 
-void RenderTileMap(flecs::iter &it)
+uint8_t TerrainTileIndex(TerrainType terrain)
 {
-    while (it.next())
+    switch (terrain)
     {
-        const auto &renderer = it.field_at<const Renderer>(1, 0);
-        const auto &camera = it.field_at<const Camera>(2, 0);
-        const auto &window = it.field_at<const Window>(3, 0);
-
-        renderer.mTextures.at("mapTexture")->SetActive();
-        const auto &shader = renderer.mMapShader;
-        const auto &verts = renderer.mSpriteVerts;
-        shader->SetActive();
-        verts->SetActive();
-
-        const auto &provinces = it.field<const Province>(0);
-        for (size_t i: it)
-        {
-            const auto &province = provinces[i];
-
-            int64_t textureIndex = 0;
-            switch (province.biome)
-            {
-                case Water: textureIndex = 10; break;
-                case Drylands: textureIndex = 1; break;
-                case Grasslands: textureIndex = 3; break;
-                case Jungles: textureIndex = 5; break;
-                case Forests: textureIndex = 2; break;
-            }
-
-            glm::mat4 model = glm::translate(
-                glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f) * TILE_SIZE_WORLD),
-                glm::vec3(province.mPosX, province.mPosY, 0.0f));
-
-            shader->SetMatrixUniform("uView", camera.mView);
-            shader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
-            shader->SetMatrixUniform("uModel", model);
-            shader->SetIntegerUniform("uTileIndex", textureIndex);
-            shader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
-
-            glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
+        case Wetlands: return 11;
+        case Hills: return 4;
+        case Mountains: return 6;
+        default: return NO_TILE;
+    }
+}
 
-            switch (province.terrain)
-            {
-                case Sea: textureIndex = -1; break;
-                case Wetlands: textureIndex = 11; break;
-                case Plains: textureIndex = -1; break;
-                case Hills: textureIndex = 4; break;
-                case Mountains: textureIndex = 6; break;
-            }
-            if (textureIndex != -1)
-            {
-                shader->SetIntegerUniform("uTileIndex", textureIndex);
+TileInstance MakeTileInstance(const TileMap &tileMap, size_t i)
+{
+    return {
+        .mPosition = glm::vec2(i % tileMap.width, i / tileMap.width),
+        .mBaseTile = BiomeTileIndex(tileMap.biome[i]),
+        .mOverlayTile = TerrainTileIndex(tileMap.terrain[i]),
+        .mFlags = static_cast<uint8_t>(tileMap.capital[i] ? TILE_FLAG_CAPITAL : 0),
+        .mPadding = 0,
+    };
+}
 
-                glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
-            }
+// Draws the biome, terrain and capital layers of the visible tiles with one instanced draw call per
+// visible row, or a single one when the rows are contiguous.
+// Only the span of instances covering the dirty tiles is uploaded again.
+void RenderTileMap(const TileMap &tileMap, const Renderer &renderer, const glm::ivec4 &visible,
+                   const HoveredTile &hovered)
+{
+    auto &buffer = *renderer.mTileInstances;
+    auto &instances = buffer.GetInstances();
+    if (instances.size() != tileMap.tiles.size())
+    {
+        instances.resize(tileMap.tiles.size());
+        for (size_t i = 0; i < instances.size(); ++i)
+            instances[i] = MakeTileInstance(tileMap, i);
+        buffer.Upload();
+    }
+    else if (!tileMap.dirty.empty())
+    {
+        size_t first = instances.size(), last = 0;
+        for (const uint32_t i : tileMap.dirty)
+        {
+            instances[i] = MakeTileInstance(tileMap, i);
+            first = std::min<size_t>(first, i);
+            last = std::max<size_t>(last, i);
+        }
+        buffer.Upload(first, last - first + 1);
+    }
 
-            if (it.entity(i).has<CapitalOf>(flecs::Wildcard))
-            {
-                shader->SetIntegerUniform("uTileIndex", 0);
+    renderer.mTileSprites->SetActive();
+    const auto &shader = renderer.mMapShader;
+    shader->SetActive();
+    shader->SetIntegerUniform("uCapitalLayer", CAPITAL_LAYER);
+    shader->SetVectorUniform("uHoveredTile", glm::vec2(hovered.mPosition));
 
-                glDrawElements(GL_TRIANGLES, verts->GetNumIndices(), GL_UNSIGNED_INT, 0);
-            }
-        }
+    renderer.mMapTimer->Begin();
+    if (visible.z >= visible.x && visible.w >= visible.y)
+    {
+        const size_t rowLength = visible.z - visible.x + 1;
+        if (rowLength == static_cast<size_t>(tileMap.width))
+            buffer.Draw(tileMap.Index(0, visible.y), rowLength * (visible.w - visible.y + 1));
+        else
+            for (int y = visible.y; y <= visible.w; ++y)
+                buffer.Draw(tileMap.Index(visible.x, y), rowLength);
     }
+    renderer.mMapTimer->End();
 
     // Unbind
     glBindVertexArray(0);
@@ -249,41 +245,113 @@ MapMode mapMode = MapMode::Geographic;
 void DoRenderTileMapSystem(const flecs::world &ecs)
 {
     auto &renderer = ecs.get_mut<Renderer>();
-    auto texturePtr = new Texture();
-    texturePtr->Load((std::filesystem::path(SDL_GetBasePath()) / "Assets/Sprites/Tileset.png").string());
-    renderer.mTextures.insert({"mapTexture", texturePtr});
+    if (!renderer.mTileSprites)
+    {
+        // Layer i is tile i of the tileset, see BiomeTileIndex and TerrainTileIndex
+        renderer.mTileSprites = new TextureArray(TILE_SPRITE_SIZE);
+        const std::string tileset = (std::filesystem::path(SDL_GetBasePath()) / "Assets/Sprites/Tileset.png").string();
+        if (renderer.mTileSprites->AddStrip(tileset) == -1)
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to load the map tileset %s, tiles will be blank", tileset.c_str());
+        renderer.mTileSprites->Build();
+    }
 
-    ecs.system<const Province, const Renderer, const Camera, const Window>("RenderMap")
+    void(ecs.component<HoveredTile>().add(flecs::Singleton));
+    void(ecs.add<HoveredTile>());
+
+    ecs.system<const TileMap, const Renderer, const Camera, const Window, const HoveredTile>("RenderMap")
         .kind(flecs::PreStore)
-        .run([=](flecs::iter &it)
+        .each([](const TileMap &tileMap, const Renderer &renderer, const Camera &camera, const Window &window,
+                 const HoveredTile &hovered)
         {
-            RenderTileMap(it);
+            RenderTileMap(tileMap, renderer, VisibleTileRect(tileMap, camera, window), hovered);
         });
 
-    flecs::query qPlayerRealm = ecs.query_builder<const Title>("PlayerRealm")
-        .with<RulerOf>("$this").src<Player>()
-        .without<InRealm>()
+    const auto qPlayerRealm = ecs.get<QueryRegistry>().qPlayerRealm;
+
+    // Titles and relations read by the palette, its change state tells when the palette is stale
+    flecs::query qPaletteSources = ecs.query_builder<const Title>("PaletteSources")
+        .with<InRealm>(flecs::Wildcard).optional()
+        .with<RealmRelation>(flecs::Wildcard).optional()
+        .detect_changes()
+        .cached()
         .build();
 
-    ecs.system<const Province, const Title, const Renderer, const Camera, const Window>("RenderMapTypes")
-        .term_at(1).src("$title")
-        .with<InRealm>("$title")
-        .without<InRealm>(flecs::Wildcard).src("$title")
+    // A new game spawns new realm entities, the slots of the old ones would only grow the palette
+    ecs.observer<const TileMap>("ResetProvinceMapTextures")
+        .event(flecs::OnAdd)
+        .each([](flecs::iter &it, size_t, const TileMap &)
+        {
+            const auto &renderer = it.world().get<Renderer>();
+            if (renderer.mProvinceMap) renderer.mProvinceMap->Reset();
+        });
+
+    // The province textures follow the TileMap even while the map mode is geographic
+    ecs.system<const TileMap, const Renderer, const Camera, const Window>("RenderMapTypes")
         .kind(flecs::PreStore)
-        .run([=](flecs::iter &it)
+        .each([=](flecs::iter &it, size_t, const TileMap &tileMap, const Renderer &renderer,
+                  const Camera &camera, const Window &window)
         {
-            switch (mapMode)
+            auto &textures = *renderer.mProvinceMap;
+            UploadProvinceData(tileMap, textures);
+
+            const flecs::entity playerRealm = qPlayerRealm.first();
+            const bool newSlots = textures.GetPaletteSize() != static_cast<int>(textures.GetSlotRealms().size());
+            if (qPaletteSources.changed() || newSlots || playerRealm.id() != textures.GetPalettePlayerRealm())
             {
-            case MapMode::Geographic: break;
-            case MapMode::Political: renderPoliticalMap(it); break;
-            case MapMode::Cultural: renderCultureMap(it); break;
-            case MapMode::Diplomatic: renderDiplomacyMap(it, qPlayerRealm.first()); break;
-            case MapMode::Army: renderArmyMap(it); break;
+                // Iterating syncs the change state of the query
+                qPaletteSources.run([](flecs::iter &pit) { while (pit.next()) {} });
+                UploadRealmPalette(it.world(), textures, playerRealm);
             }
+
+            if (mapMode != MapMode::Geographic)
+            {
+                renderer.mMapModeTimer->Begin();
+                RenderMapMode(renderer, mapMode, VisibleTileRect(tileMap, camera, window));
+                renderer.mMapModeTimer->End();
+            }
+        });
+
+    ecs.system<const TileMap, const Renderer, const Camera, const Window>("RenderRealmBorders")
+        .kind(flecs::PreStore)
+        .each([](const TileMap &tileMap, const Renderer &renderer, const Camera &camera, const Window &window)
+        {
+            auto &borders = *renderer.mRealmBorders;
+            UpdateRealmBorders(tileMap, borders);
+
+            const glm::ivec4 visible = VisibleTileRect(tileMap, camera, window);
+            if (visible.z < visible.x || visible.w < visible.y) return;
+
+            renderer.mPrimitiveShader->SetActive();
+            const size_t rowLength = visible.z - visible.x + 1;
+            if (rowLength == static_cast<size_t>(tileMap.width))
+                borders.Draw(tileMap.Index(0, visible.y), rowLength * (visible.w - visible.y + 1));
+            else
+                for (int y = visible.y; y <= visible.w; ++y)
+                    borders.Draw(tileMap.Index(visible.x, y), rowLength);
+            glBindVertexArray(0);
+        });
+
+    // Outline of the provinces whose details window is open
+    ecs.system<const Province, const Renderer>("OutlineSelectedProvinces")
+        .with<ShowProvinceDetails>()
+        .kind(flecs::PreStore)
+        .each([](const Province &province, const Renderer &renderer)
+        {
+            const glm::vec2 center = glm::vec2(province.mPosX, province.mPosY) * TILE_SIZE_WORLD;
+            const glm::vec2 half(TILE_SIZE_WORLD * 0.5f);
+            renderer.mPrimitives->AddRectOutline(center - half, center + half, glm::vec4(1.0f, 0.85f, 0.2f, 1.0f));
         });
 
-    ecs.system<>("ChooseMapMode")
-        .run([](flecs::iter)
+    // Every renderer has seen this frame's changes
+    ecs.system<TileMap>("ClearTileMapDirty")
+        .kind(flecs::OnStore)
+        .each([](TileMap &tileMap)
+        {
+            tileMap.ClearDirty();
+        });
+
+    ecs.system<const Renderer>("ChooseMapMode")
+        .each([](const Renderer &renderer)
         {
             if (ImGui::Begin("Modo de Mapa", 0, ImGuiWindowFlags_AlwaysAutoResize))
             {
@@ -294,21 +362,30 @@ void DoRenderTileMapSystem(const flecs::world &ecs)
                 ImGui::RadioButton("Diplomático", &mapModeInt, (int)MapMode::Diplomatic);
                 ImGui::RadioButton("Exército", &mapModeInt, (int)MapMode::Army);
                 mapMode = (MapMode)mapModeInt;
+
+                ImGui::Separator();
+                ImGui::Text("GPU: mapa %.2f ms, modo %.2f ms",
+                            renderer.mMapTimer->GetMilliseconds(), renderer.mMapModeTimer->GetMilliseconds());
             }
             ImGui::End();
         });
 
-    ecs.system<const Province, const Camera, const Window>("SetHoveredProvince")
+    // One pick per frame, Hovered only moves when the mouse enters another tile
+    ecs.system<HoveredTile, const TileMap, const Camera, const Window>("SetHoveredProvince")
         .kind(flecs::PreUpdate)
-        .each([](flecs::entity entity, const Province &province, const Camera &camera, const Window &window)
+        .each([](HoveredTile &hovered, const TileMap &tileMap, const Camera &camera, const Window &window)
         {
-            const auto &mousePosNDC = window.GetMousePosNDC();
-            const auto &mousePosWorld = camera.NDCToWorld(mousePosNDC, window);
-            const auto mousedOverTile = glm::round(glm::vec2(mousePosWorld) / TILE_SIZE_WORLD);
-            const glm::vec2 provinceTile(province.mPosX, province.mPosY);
-            if (mousedOverTile == provinceTile)
-                void(entity.add<Hovered>());
-            else
-                void(entity.remove<Hovered>());
+            const auto &mousePosWorld = camera.NDCToWorld(window.GetMousePosNDC(), window);
+            const glm::ivec2 tile(glm::round(glm::vec2(mousePosWorld) / TILE_SIZE_WORLD));
+            const bool onMap = tileMap.Contains(tile.x, tile.y);
+            const flecs::entity province = onMap ? tileMap.At(tile.x, tile.y) : flecs::entity::null();
+            if (province == hovered.mProvince) return;
+
+            if (hovered.mProvince.is_alive())
+                void(hovered.mProvince.remove<Hovered>());
+            if (province)
+                void(province.add<Hovered>());
+            hovered.mProvince = province;
+            hovered.mPosition = onMap ? tile : glm::ivec2(-1);
         });
 }
@@ -1,7 +1,15 @@
 #include <flecs.h>
+#include <glm/glm.hpp>
 
 void DoRenderTileMapSystem(const flecs::world &ecs);
 
+// Singleton with the tile under the mouse, the only province tagged Hovered
+struct HoveredTile
+{
+    flecs::entity mProvince;
+    glm::ivec2 mPosition{-1, -1}; // (-1, -1) when the mouse is off the map
+};
+
 enum class MapMode
 {
     Geographic,
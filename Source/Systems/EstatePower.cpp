@@ -5,6 +5,7 @@
 #include <SDL3/SDL.h>
 #include "Systems/Sound.hpp"
 #include "Characters.hpp"
+#include "DecisionPolicy.hpp"
 #include "imgui.h"
 #include "toml++/toml.hpp"
 
@@ -42,6 +43,26 @@ std::vector<EstatePowerEvent> readEstatePowerEventsFromFile()
     return result;
 }
 
+void ApplyEstateEventChoice(const EstateEventChoice &choice, EstatePowers &powers, Character &player)
+{
+    for (const auto &[estate, change]: choice.mPowerChanges)
+    {
+        switch (estate)
+        {
+        case SocialEstate::Commoners:
+            powers.mCommonersPower = std::clamp((int)powers.mCommonersPower + change, -128, 127);
+            break;
+        case SocialEstate::Nobility:
+            powers.mNobilityPower = std::clamp((int)powers.mNobilityPower + change, -128, 127);
+            break;
+        case SocialEstate::Clergy:
+            powers.mClergyPower = std::clamp((int)powers.mClergyPower + change, -128, 127);
+            break;
+        }
+    }
+    player.mMoney -= choice.mCost;
+}
+
 void DoEstatePowerSystems(const flecs::world& ecs, const GameTickSources& timers)
 {
     void(ecs.component<EstatePowers>().add(flecs::Singleton));
@@ -49,19 +70,45 @@ void DoEstatePowerSystems(const flecs::world& ecs, const GameTickSources& timers
     const auto powerEvents = readEstatePowerEventsFromFile();
 
     ecs.system<const GameTime>("PowerEventsSpawner")
+        .kind<SimulationStep>()
         .tick_source(timers.mMonthTimer)
         .each([=](const GameTime &gameTime)
         {
-            if (Random::GetFloat() < 0.2f)
+            RandomStream rng(RandomSubsystem::Estates, 0, gameTime.TimeDays());
+            if (rng.GetFloat() < 0.2f)
             {
-                auto event = powerEvents[Random::GetIntRange(0, powerEvents.size() - 1)];
+                auto event = powerEvents[rng.GetIntRange(0, powerEvents.size() - 1)];
                 void(ecs.entity()
                     .child_of(ecs.entity("Events"))
                     .set<EstatePowerEvent>(event)
-                    .set(EventSchedule::InXDays(gameTime, Random::GetIntRange(0, 30))));
+                    .set(EventSchedule::InXDays(gameTime, rng.GetIntRange(0, 30))));
             }
         });
 
+    if (ecs.has<Headless>())
+    {
+        // Without UI the decision policy picks one of the choices the player can afford
+        ecs.system<const EstatePowerEvent, EstatePowers, Character, const DecisionPolicy>("ResolvePowerEvents")
+            .term_at(2).src<Player>()
+            .tick_source(timers.mTickTimer)
+            .each([](flecs::entity entity, const EstatePowerEvent &event, EstatePowers &powers, Character &player,
+                     const DecisionPolicy &policy)
+            {
+                std::vector<size_t> affordable;
+                for (size_t i = 0; i < event.mChoices.size(); ++i)
+                {
+                    if (event.mChoices[i].mCost <= player.mMoney) affordable.push_back(i);
+                }
+                if (!affordable.empty())
+                {
+                    const size_t choice = affordable[policy.Choose(DecisionKind::EstatePower, entity, affordable.size())];
+                    ApplyEstateEventChoice(event.mChoices[choice], powers, player);
+                }
+                entity.destruct();
+            });
+        return;
+    }
+
     ecs.system<const EstatePowerEvent, EstatePowers, Character>("PowerEvents")
         .term_at(2).src<Player>()
         .tick_source(timers.mTickTimer)
@@ -89,22 +136,7 @@ void DoEstatePowerSystems(const flecs::world& ecs, const GameTickSources& timers
                     if (isDisabled) ImGui::BeginDisabled();
                     if (ImGui::Button(choice.mText.data()))
                     {
-                        for (const auto &[estate, change]: choice.mPowerChanges)
-                        {
-                            switch (estate)
-                            {
-                            case SocialEstate::Commoners:
-                                powers.mCommonersPower = std::clamp((int)powers.mCommonersPower + change, -128, 127);
-                                break;
-                            case SocialEstate::Nobility:
-                                powers.mNobilityPower = std::clamp((int)powers.mNobilityPower + change, -128, 127);
-                                break;
-                            case SocialEstate::Clergy:
-                                powers.mClergyPower = std::clamp((int)powers.mClergyPower + change, -128, 127);
-                                break;
-                            }
-                        }
-                        player.mMoney -= choice.mCost;
+                        ApplyEstateEventChoice(choice, powers, player);
                         entity.destruct();
                     }
                     if (isDisabled) ImGui::EndDisabled();
@@ -34,4 +34,7 @@ struct EstatePowerEvent
     std::vector<EstateEventChoice> mChoices;
 };
 
+// Applies the power changes and the cost of a choice
+void ApplyEstateEventChoice(const EstateEventChoice &choice, EstatePowers &powers, Character &player);
+
 void DoEstatePowerSystems(const flecs::world& ecs, const GameTickSources& timers);
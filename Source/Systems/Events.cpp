@@ -1,5 +1,6 @@
 #include <cmath>
 #include <imgui.h>
+#include <SDL3/SDL.h>
 
 #include "Events.hpp"
 #include "Characters.hpp"
@@ -46,10 +47,13 @@ void DoCharacterBirthSystems(const flecs::world& ecs, const flecs::timer &tickTi
             }
         });
 
+    // Without UI the announcements are skipped as they have a single option
+    const bool headless = ecs.has<Headless>();
+
     ecs.system<PregnancySaga, const GameTime>()
         .with<FiredEvent>()
         .tick_source(tickTimer)
-        .each([ecs](flecs::iter &it, size_t i, PregnancySaga &saga, const GameTime &gameTime)
+        .each([ecs, headless](flecs::iter &it, size_t i, PregnancySaga &saga, const GameTime &gameTime)
         {
             const auto &entity = it.entity(i);
             auto *father = saga.father.try_get<Character>();
@@ -67,7 +71,7 @@ void DoCharacterBirthSystems(const flecs::world& ecs, const flecs::timer &tickTi
                 break;
             case PregnancySaga::Announce:
                 {
-                    if (dynasty == playerDynasty)
+                    if (!headless && dynasty == playerDynasty)
                     {
                         void(entity.add<PausesGame>());
                         auto name = "Evento - Gravidez##" + std::to_string(entity.id());
@@ -94,7 +98,7 @@ void DoCharacterBirthSystems(const flecs::world& ecs, const flecs::timer &tickTi
                 }
             case PregnancySaga::BirthAnnounce:
                 {
-                    if (dynasty == playerDynasty)
+                    if (!headless && dynasty == playerDynasty)
                     {
                         void(entity.add<PausesGame>());
                         auto name = "Evento - Nascimento##" + std::to_string(entity.id());
@@ -185,6 +189,8 @@ void DoEventSchedulingSystems(const flecs::world& ecs, flecs::timer tickTimer)
 
 void DoSamplePopupSystem(const flecs::world& ecs, flecs::timer tickTimer)
 {
+    if (ecs.has<Headless>()) return;
+
     // Sample Popup for testing event schedules
     ecs.system<const SamplePopup, const FiredEvent>()
         .kind(flecs::OnUpdate)
@@ -210,16 +216,19 @@ void DoSamplePopupSystem(const flecs::world& ecs, flecs::timer tickTimer)
 
 void DoCharacterAgingSystem(const flecs::world& ecs, const GameTickSources& timers)
 {
-    ecs.system<Character>()
+    ecs.system<Character, const GameTime>()
+        .kind<SimulationStep>()
         .tick_source(timers.mYearTimer)
-        .each([](flecs::entity e, Character &character)
+        .each([](flecs::entity e, Character &character, const GameTime &gameTime)
         {
             if (character.mAgeDays < 360 * 60) return;
             // TODO: add a timeout to death
-            if (Random::GetFloat() < 0.2f) void(e.set(AgeClass::Deceased));
+            RandomStream rng(RandomSubsystem::Characters, e.id(), gameTime.TimeDays());
+            if (rng.GetFloat() < 0.2f) void(e.set(AgeClass::Deceased));
         });
 
     ecs.system<Character, const GameTime>()
+        .kind<SimulationStep>()
         .tick_source(timers.mDayTimer)
         .each([](flecs::entity e, Character &character, const GameTime &gameTime)
         {
@@ -233,12 +242,40 @@ void DoCharacterAgingSystem(const flecs::world& ecs, const GameTickSources& time
 
 void DoGameOverEvents(const flecs::world& ecs, const GameTickSources& timers)
 {
+    // Sem interface a simulação termina no fim de jogo
+    if (ecs.has<Headless>())
+    {
+        ecs.system<const Character>("HeadlessPlayerDeath")
+            .entity(ecs.entity<Player>())
+            .with(AgeClass::Deceased)
+            .tick_source(timers.mTickTimer)
+            .each([](flecs::entity entity, const Character &character)
+            {
+                SDL_Log("Game over: %s died at %zu years", character.mName.c_str(), character.mAgeDays / 360);
+                entity.world().quit();
+            });
+
+        ecs.system<const EstatePowers>("HeadlessRealmCollapse")
+            .tick_source(timers.mTickTimer)
+            .each([](flecs::iter &it, size_t, const EstatePowers &powers)
+            {
+                if (powers.mCommonersPower > -100 && powers.mCommonersPower < 100
+                    && powers.mNobilityPower > -100 && powers.mNobilityPower < 100
+                    && powers.mClergyPower > -100 && powers.mClergyPower < 100)
+                    return;
+
+                SDL_Log("Game over: %s", GameOverModule::FormatGameOverCause(&powers).c_str());
+                it.world().quit();
+            });
+        return;
+    }
+
     // Sistema para morte do jogador
     ecs.system<const Character>()
         .entity(ecs.entity<Player>())
         .with(AgeClass::Deceased)
         .tick_source(timers.mTickTimer)
-        .each([&ecs](flecs::entity entity, const Character &character)
+        .each([ecs](flecs::entity entity, const Character &character)
         {
             // Coletar informações do jogador
             flecs::entity playerEntity = ecs.entity<Player>();
@@ -364,11 +401,11 @@ EventsModule::EventsModule(const flecs::world& ecs)
 
 void PregnancySaga::NextStage(flecs::entity entity, const GameTime &gameTime)
 {
+    RandomStream rng(RandomSubsystem::Characters, entity.id(), gameTime.TimeDays());
     switch (stage)
     {
     case Attempt:
-        // TODO: make random deterministic
-        if (Random::GetFloat() < 0.2f)
+        if (rng.GetFloat() < 0.2f)
         {
             stage = PregnancySaga::Announce;
         }
@@ -379,15 +416,14 @@ void PregnancySaga::NextStage(flecs::entity entity, const GameTime &gameTime)
     case Announce:
         {
             stage = PregnancySaga::Birth;
-            // TODO: make random deterministic
-            int variation = Random::GetIntRange(30, 60);
+            int variation = rng.GetIntRange(30, 60);
             void(entity.remove<PausesGame>()
                 .remove<FiredEvent>()
                 .set<EventSchedule>(EventSchedule::InXDays(gameTime, 30 * 7 + variation)));
         }
         break;
     case Birth:
-        child = BirthChildCharacter(entity.world(), father.get<Character>(), mother.get<Character>(), dynasty);
+        child = BirthChildCharacter(entity.world(), father.get<Character>(), mother.get<Character>(), dynasty, rng);
         stage = PregnancySaga::BirthAnnounce;
         break;
     case BirthAnnounce:
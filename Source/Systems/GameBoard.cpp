@@ -444,6 +444,7 @@ GameBoardScene::GameBoardScene(const flecs::world& ecs)
                     {
                         character.mMoney -= 100;
                         army.mAmount += 1;
+                        entity.modified<ProvinceArmy>();
                     }
                 }
             }
@@ -468,11 +469,8 @@ void GameBoard::Draw(Renderer& renderer, const Camera &camera, const Window &win
 
     // 1. Set the shader
     chessShader->SetActive();
-    // 2. Set the matrices
-    chessShader->SetMatrixUniform("uView", camera.mView);
-    chessShader->SetMatrixUniform("uProj", camera.CalculateProjection(window));
+    // 2. Set the model matrix, the camera comes from the Camera uniform block
     chessShader->SetMatrixUniform("uModel", mModel);
-    chessShader->SetVectorUniform("uMousePos", window.GetMousePosNDC());
 
     // 3. Draw the plane
     verts->SetActive();
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <imgui.h>
 
 #include "GameTime.hpp"
@@ -8,12 +9,25 @@ void DoGameTimeSystems(const flecs::world& ecs, flecs::timer tickTimer)
 {
     void(ecs.component<GameTime>().add(flecs::Singleton));
 
-    // Advances the game time by the set speed
-    ecs.system<GameTime, const GameTickSources>()
-        .write<flecs::TickSource>()
+    // Not a flecs::Phase, so the systems of this phase are left out of the frame pipeline
+    void(ecs.component<SimulationStep>());
+
+    const auto pipeline = ecs.pipeline()
+        .with(flecs::System)
+        .with(flecs::DependsOn, ecs.component<SimulationStep>())
+        .without(flecs::Disabled).up(flecs::DependsOn)
+        .without(flecs::Disabled).up(flecs::ChildOf)
+        .build();
+
+    void(ecs.component<SimulationClock>()
+        .add(flecs::Singleton)
+        .emplace<SimulationClock>(SimulationClock { .mPipeline = pipeline }));
+
+    // Accumulates the game time to be simulated by the set speed
+    ecs.system<GameTime>()
         .kind(flecs::PreUpdate)
         .tick_source(tickTimer)
-        .each([](const flecs::iter &it, size_t, GameTime &gameTime, const GameTickSources &timers)
+        .each([](const flecs::iter &it, size_t, GameTime &gameTime)
         {
             if (it.world().count<PausesGame>() > 0) return;
 
@@ -24,29 +38,7 @@ void DoGameTimeSystems(const flecs::world& ecs, flecs::timer tickTimer)
                 gameTime.mSpeed += speedChange;
             gameTime.mSpeedAccel *= powf(0.1, it.delta_time());
 
-            gameTime.mLastTimeSecs = gameTime.mTimeSecs;
-            gameTime.mTimeSecs += uint64_t(it.delta_time() * gameTime.mSpeed * 86400.0);
-            if (gameTime.CountDayChanges() != 0)
-            {
-                // Immediately tick the systems which use DayTimer
-                auto &tickSource = timers.mDayTimer.get_mut<EcsTickSource>();
-                tickSource.tick = true;
-            }
-            if (gameTime.CountWeekChanges() != 0)
-            {
-                auto &tickSource = timers.mWeekTimer.get_mut<EcsTickSource>();
-                tickSource.tick = true;
-            }
-            if (gameTime.CountMonthChanges() != 0)
-            {
-                auto &tickSource = timers.mMonthTimer.get_mut<EcsTickSource>();
-                tickSource.tick = true;
-            }
-            if (gameTime.CountYearChanges() != 0)
-            {
-                auto &tickSource = timers.mYearTimer.get_mut<EcsTickSource>();
-                tickSource.tick = true;
-            }
+            gameTime.mPendingSecs += it.delta_time() * gameTime.mSpeed * 86400.0;
         });
 
     // Controls for game speed
@@ -67,3 +59,48 @@ void DoGameTimeSystems(const flecs::world& ecs, flecs::timer tickTimer)
             */
         });
 }
+
+void StepSimulation(const flecs::world& ecs)
+{
+    auto &gameTime = ecs.get_mut<GameTime>();
+    const auto &clock = ecs.get<SimulationClock>();
+    const auto &timers = ecs.get<GameTickSources>();
+
+    gameTime.mLastTimeSecs = gameTime.mTimeSecs;
+    gameTime.mTimeSecs += clock.StepSecs();
+
+    // A step is at most one day long, so every period is crossed at most once
+    const std::pair<flecs::timer, bool> periods[] = {
+        { timers.mDayTimer, gameTime.CountDayChanges() != 0 },
+        { timers.mWeekTimer, gameTime.CountWeekChanges() != 0 },
+        { timers.mMonthTimer, gameTime.CountMonthChanges() != 0 },
+        { timers.mYearTimer, gameTime.CountYearChanges() != 0 },
+    };
+    for (const auto &[timer, crossed] : periods)
+        timer.get_mut<EcsTickSource>().tick = crossed;
+
+    ecs.run_pipeline(clock.mPipeline, 1.0f / static_cast<float>(clock.mTicksPerDay));
+
+    for (const auto &[timer, crossed] : periods)
+        timer.get_mut<EcsTickSource>().tick = false;
+}
+
+void RunPendingSimulationSteps(const flecs::world& ecs)
+{
+    if (!ecs.has<GameTime>()) return;
+
+    const auto &clock = ecs.get<SimulationClock>();
+    const auto stepSecs = static_cast<double>(clock.StepSecs());
+    for (uint32_t i = 0; i < clock.mMaxStepsPerFrame && ecs.get<GameTime>().mPendingSecs >= stepSecs; ++i)
+    {
+        // A step opened a popup, the rest waits until the player has decided
+        if (ecs.count<PausesGame>() > 0) return;
+
+        ecs.get_mut<GameTime>().mPendingSecs -= stepSecs;
+        StepSimulation(ecs);
+    }
+
+    // Past the step cap the machine can't keep up, keep at most one more frame of backlog
+    auto &pendingSecs = ecs.get_mut<GameTime>().mPendingSecs;
+    pendingSecs = std::min(pendingSecs, stepSecs * clock.mMaxStepsPerFrame);
+}
@@ -11,6 +11,8 @@ struct GameTime
     uint64_t mTimeSecs = 0;
     uint64_t mLastTimeSecs = 0;
     float mSpeed = 3, mSpeedAccel = 0;
+    // Game seconds accumulated from real time that weren't simulated yet
+    double mPendingSecs = 0;
 
     [[nodiscard]] uint64_t CountYearChanges() const
     {
@@ -43,4 +45,30 @@ struct GameTime
     }
 };
 
+// Phase of the systems which run on fixed simulation steps, outside the frame pipeline.
+// Systems of this phase may use the day/week/month/year timers as tick sources.
+struct SimulationStep {};
+
+struct SimulationClock
+{
+    // Number of fixed steps in a simulated day (a divisor of DAY_DURATION)
+    uint32_t mTicksPerDay = 4;
+    // Steps ran in a single frame, the remaining time is simulated on the next frames
+    uint32_t mMaxStepsPerFrame = 360 * 4;
+    // Pipeline with the systems of the SimulationStep phase
+    flecs::entity mPipeline;
+
+    [[nodiscard]] uint64_t StepSecs() const
+    {
+        return DAY_DURATION / mTicksPerDay;
+    }
+};
+
 void DoGameTimeSystems(const flecs::world& ecs, flecs::timer tickTimer);
+
+// Advances the game time by one fixed step and runs the SimulationStep pipeline,
+// ticking every day/week/month/year boundary crossed by the step
+void StepSimulation(const flecs::world& ecs);
+
+// Runs all the steps covered by the pending game time, must be called outside of ecs.progress()
+void RunPendingSimulationSteps(const flecs::world& ecs);
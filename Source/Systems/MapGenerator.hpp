@@ -4,20 +4,25 @@
 #include <SDL3/SDL.h>
 #include <vector>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <random>
-#include <queue>
+#include <tuple>
 #include <algorithm>
+#include <unordered_map>
 
 #include "Components/Province.hpp"
 #include "Components/Culture.hpp"
-#include <SDL3/SDL.h>
+#include "Grid2D.hpp"
+#include "GridPaths.hpp"
 
 #include "Army.hpp"
+#include "Parallel.hpp"
+#include "PerlinNoise.hpp"
 
-// Map constants
-constexpr int MAP_WIDTH = 90;
-constexpr int MAP_HEIGHT = 45;
+// Default map size, GenerateMap accepts any other size
+constexpr int DEFAULT_MAP_WIDTH = 90;
+constexpr int DEFAULT_MAP_HEIGHT = 45;
 
 // Terrain thresholds (normalized 0-1)
 constexpr float WATER_THRESHOLD = 0.30f;
@@ -38,144 +43,316 @@ constexpr float BASE_TRAVEL_COST = 5.0f;
 constexpr float TERRAIN_BIOME_MISMATCH_PENALTY = 50.0f;
 
 // Noise generation constants
-constexpr int PERLIN_TABLE_SIZE = 512;
 constexpr float NOISE_SCALE_BASE = 16.0f;
 constexpr float NOISE_SCALE_MULTIPLIER = 2.0f;
 
-// Components
-struct TileMap {
-    std::vector<std::vector<flecs::entity>> tiles;
-    int width = MAP_WIDTH;
-    int height = MAP_HEIGHT;
-};
+// Adjacency graph of the topmost realms, weighted by the number of neighbouring tile pairs
+// (diagonals included) they share. Both directions of a pair are stored.
+struct RealmAdjacency {
+    using Neighbours = std::unordered_map<flecs::entity_t, uint32_t>;
 
-struct TileData {
-    int x;
-    int y;
-    float height_value;
-};
+    std::unordered_map<flecs::entity_t, Neighbours> graph;
 
-struct CultureData {
-    CultureType culture;
-};
+    // Returns true when a and b just became neighbours
+    bool Add(flecs::entity_t a, flecs::entity_t b) {
+        graph[b][a] += 1;
+        return ++graph[a][b] == 1;
+    }
+    // Returns true when a and b no longer share a border
+    bool Remove(flecs::entity_t a, flecs::entity_t b) {
+        const bool last = Decrement(a, b);
+        Decrement(b, a);
+        return last;
+    }
 
-// Perlin noise implementation
-namespace {
+    [[nodiscard]] const Neighbours* Of(flecs::entity_t realm) const {
+        const auto it = graph.find(realm);
+        return it != graph.end() ? &it->second : nullptr;
+    }
+    [[nodiscard]] uint32_t SharedBorder(flecs::entity_t a, flecs::entity_t b) const {
+        const auto *neighbours = Of(a);
+        if (!neighbours) return 0;
+        const auto it = neighbours->find(b);
+        return it != neighbours->end() ? it->second : 0;
+    }
 
-class PerlinNoise {
 private:
-    std::array<int, PERLIN_TABLE_SIZE> permutation;
+    bool Decrement(flecs::entity_t a, flecs::entity_t b) {
+        auto &neighbours = graph[a];
+        const auto it = neighbours.find(b);
+        if (it == neighbours.end()) return false;
+        if (--it->second > 0) return false;
+        neighbours.erase(it);
+        if (neighbours.empty()) graph.erase(a);
+        return true;
+    }
+};
 
-    static float fade(float t) {
-        return 6.0f * t * t * t * t * t - 15.0f * t * t * t * t + 10.0f * t * t * t;
+// Components
+struct TileMap {
+    // Province entities in row-major order, see Index()
+    std::vector<flecs::entity> tiles;
+    int width = DEFAULT_MAP_WIDTH;
+    int height = DEFAULT_MAP_HEIGHT;
+
+    // Hot per-tile fields, laid out like tiles so neighbour scans don't touch the entities.
+    // Kept in sync with Province, (InRealm, *), (CapitalOf, *) and ProvinceArmy by the ProvinceUpdates observers.
+    std::vector<TerrainType> terrain;
+    std::vector<BiomeType> biome;
+    std::vector<CultureType> culture;
+    std::vector<float> movement_cost;
+    std::vector<flecs::entity_t> realm; // Direct InRealm target, 0 if none
+    std::vector<flecs::entity_t> topmost; // Last title up the InRealm chain, 0 if none
+    std::vector<uint32_t> army;
+    std::vector<uint8_t> capital;
+
+    // Borders between the realms of the topmost column, see SetTopmost()
+    RealmAdjacency adjacency;
+
+    // Tiles whose columns changed since the last rendered frame, each listed once.
+    // Read by every renderer of the map and cleared once the frame is drawn.
+    std::vector<uint32_t> dirty;
+    std::vector<uint8_t> is_dirty;
+
+    void Resize(int w, int h) {
+        width = w;
+        height = h;
+        const size_t count = static_cast<size_t>(w) * h;
+        tiles.assign(count, flecs::entity::null());
+        terrain.assign(count, Sea);
+        biome.assign(count, Water);
+        culture.assign(count, SteppeNomads);
+        movement_cost.assign(count, 0.0f);
+        realm.assign(count, 0);
+        topmost.assign(count, 0);
+        army.assign(count, 0);
+        capital.assign(count, 0);
+        adjacency.graph.clear();
+
+        // A new map is dirty as a whole
+        dirty.resize(count);
+        for (size_t i = 0; i < count; ++i) dirty[i] = static_cast<uint32_t>(i);
+        is_dirty.assign(count, 1);
     }
 
-    static float lerp(float t, float a, float b) {
-        return a + t * (b - a);
+    [[nodiscard]] bool Contains(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    [[nodiscard]] size_t Index(int x, int y) const {
+        return static_cast<size_t>(y) * width + x;
+    }
+    [[nodiscard]] flecs::entity At(int x, int y) const {
+        return tiles[Index(x, y)];
     }
 
-    static float gradient(int hash, float x, float y) {
-        const std::array<std::array<float, 2>, 4> vectors = {{
-            {0.0f, 1.0f},
-            {0.0f, -1.0f},
-            {1.0f, 0.0f},
-            {-1.0f, 0.0f}
-        }};
-        const auto& g = vectors[hash % 4];
-        return g[0] * x + g[1] * y;
+    void MarkDirty(size_t i) {
+        if (is_dirty[i]) return;
+        is_dirty[i] = 1;
+        dirty.push_back(static_cast<uint32_t>(i));
+    }
+    void ClearDirty() {
+        for (const uint32_t i : dirty) is_dirty[i] = 0;
+        dirty.clear();
     }
 
-public:
-    explicit PerlinNoise(uint32_t seed) {
-        std::mt19937 rng(seed);
-        for (int i = 0; i < 256; ++i) {
-            permutation[i] = i;
-        }
-        std::shuffle(permutation.begin(), permutation.begin() + 256, rng);
-        for (int i = 0; i < 256; ++i) {
-            permutation[256 + i] = permutation[i];
+    // Moves a tile to another topmost realm and updates the shared borders with its 8 neighbours.
+    // Calls onChange(a, b, neighbouring) for every pair of realms that started or stopped touching.
+    template<typename F>
+    void SetTopmost(size_t i, flecs::entity_t top, F &&onChange) {
+        const flecs::entity_t old = topmost[i];
+        if (old == top) return;
+        topmost[i] = top;
+        MarkDirty(i);
+
+        const int x = static_cast<int>(i % width), y = static_cast<int>(i / width);
+        for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx) {
+            if ((dx == 0 && dy == 0) || !Contains(x + dx, y + dy)) continue;
+            const flecs::entity_t other = topmost[Index(x + dx, y + dy)];
+            if (other == 0) continue;
+            if (old != 0 && old != other && adjacency.Remove(old, other)) onChange(old, other, false);
+            if (top != 0 && top != other && adjacency.Add(top, other)) onChange(top, other, true);
         }
     }
 
-    float noise(float x, float y) const {
-        int xi = static_cast<int>(std::floor(x)) & 255;
-        int yi = static_cast<int>(std::floor(y)) & 255;
-        float xf = x - std::floor(x);
-        float yf = y - std::floor(y);
+    // Copies the geography of a province into the columns, the tile is only dirtied by a visible change
+    void SyncProvince(const Province &province) {
+        const size_t i = Index(static_cast<int>(province.mPosX), static_cast<int>(province.mPosY));
+        movement_cost[i] = province.movement_cost;
+        if (terrain[i] == province.terrain && biome[i] == province.biome && culture[i] == province.culture) return;
+        terrain[i] = province.terrain;
+        biome[i] = province.biome;
+        culture[i] = province.culture;
+        MarkDirty(i);
+    }
+};
 
-        float g00 = gradient(permutation[xi + permutation[yi]], xf, yf);
-        float g01 = gradient(permutation[xi + permutation[yi + 1]], xf, yf - 1.0f);
-        float g10 = gradient(permutation[xi + 1 + permutation[yi]], xf - 1.0f, yf);
-        float g11 = gradient(permutation[xi + 1 + permutation[yi + 1]], xf - 1.0f, yf - 1.0f);
+struct TileData {
+    int x;
+    int y;
+    float height_value;
+};
 
-        float t = fade(xf);
-        float u = fade(yf);
-        return lerp(u, lerp(t, g00, g10), lerp(t, g01, g11));
+struct CultureData {
+    CultureType culture;
+};
+
+// Scratch buffers of the map generator, kept as a singleton so regenerating a map
+// reuses the allocations of the previous one
+struct MapGenArena {
+    // Time taken to create the tile entities on the last generation
+    double spawn_ms = 0.0;
+
+    Grid2D<float> height_map;
+    Grid2D<TerrainType> terrain_map;
+    Grid2D<BiomeType> biome_map;
+    Grid2D<CultureType> culture_map;
+    Grid2D<int> labels;
+    Grid2D<float> distance_map;
+    Grid2D<uint32_t> cost_map;
+    std::vector<std::pair<int, int>> queue;
+    BucketQueue path_queue;
+
+    [[nodiscard]] size_t Bytes() const {
+        return height_map.CapacityBytes() + terrain_map.CapacityBytes() + biome_map.CapacityBytes()
+            + culture_map.CapacityBytes() + labels.CapacityBytes() + distance_map.CapacityBytes()
+            + cost_map.CapacityBytes() + queue.capacity() * sizeof(queue[0]) + path_queue.CapacityBytes();
     }
 };
 
-std::vector<float> get_noise_scales() {
+namespace {
+
+std::vector<float> get_noise_scales(int width, int height) {
     std::vector<float> scales;
-    float scale = std::min(MAP_WIDTH, MAP_HEIGHT) / NOISE_SCALE_BASE;
-    while (scale < MAP_WIDTH && scale < MAP_HEIGHT) {
+    float scale = std::min(width, height) / NOISE_SCALE_BASE;
+    while (scale < width && scale < height) {
         scales.push_back(scale);
         scale *= NOISE_SCALE_MULTIPLIER;
     }
     return scales;
 }
 
-void generate_height_map(uint32_t seed, std::vector<std::vector<float>>& height_map) {
+// Serial reference generator, through the scalar PerlinNoise::noise()
+void generate_height_map(uint32_t seed, Grid2D<float>& height_map) {
+    const int width = height_map.Width(), height = height_map.Height();
     PerlinNoise noise(seed);
-    auto scales = get_noise_scales();
+    auto scales = get_noise_scales(width, height);
 
     // Generate noise
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
             float value = 0.0f;
             for (float scale : scales) {
                 value += noise.noise(x / scale, y / scale);
             }
-            height_map[x][y] = value;
+            height_map(x, y) = value;
         }
     }
 
     // Find min/max for normalization
-    float min_val = height_map[0][0];
-    float max_val = height_map[0][0];
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            min_val = std::min(min_val, height_map[x][y]);
-            max_val = std::max(max_val, height_map[x][y]);
+    float min_val = height_map(0, 0);
+    float max_val = height_map(0, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            min_val = std::min(min_val, height_map(x, y));
+            max_val = std::max(max_val, height_map(x, y));
         }
     }
 
     // Apply edge falloff and normalize
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            height_map[x][y] -= min_val;
-            float interpolation = std::sin(x / float(MAP_WIDTH) * M_PI) + 
-                                std::sin(y / float(MAP_HEIGHT) * M_PI);
-            height_map[x][y] *= interpolation * interpolation;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            height_map(x, y) -= min_val;
+            float interpolation = std::sin(x / float(width) * M_PI) + 
+                                std::sin(y / float(height) * M_PI);
+            height_map(x, y) *= interpolation * interpolation;
         }
     }
 
     // Final normalization
-    min_val = height_map[0][0];
-    max_val = height_map[0][0];
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            min_val = std::min(min_val, height_map[x][y]);
-            max_val = std::max(max_val, height_map[x][y]);
+    min_val = height_map(0, 0);
+    max_val = height_map(0, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            min_val = std::min(min_val, height_map(x, y));
+            max_val = std::max(max_val, height_map(x, y));
         }
     }
     
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            height_map[x][y] = (height_map[x][y] - min_val) / (max_val - min_val);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            height_map(x, y) = (height_map(x, y) - min_val) / (max_val - min_val);
         }
     }
 }
 
+// Same output as generate_height_map, bit for bit, with the rows split between threads
+// and the noise of each row evaluated by the vectorised PerlinNoise::octaves().
+// Every tile goes through the same expressions, and the per-chunk minimums and maximums are
+// combined in row order, which keeps the first of equal values just like the serial scan.
+void generate_height_map_parallel(uint32_t seed, Grid2D<float>& height_map) {
+    const int width = height_map.Width(), height = height_map.Height();
+    PerlinNoise noise(seed);
+    const auto scales = get_noise_scales(width, height);
+
+    constexpr size_t ROW_GRAIN = 8;
+    const size_t chunks = ParallelChunkCount(height, ROW_GRAIN);
+    std::vector<float> chunk_min(chunks), chunk_max(chunks);
+
+    // Sample coordinates along a row
+    std::vector<float> row_x(width);
+    for (int x = 0; x < width; ++x) row_x[x] = static_cast<float>(x);
+
+    // Generate noise, reducing its minimum
+    ParallelFor(height, ROW_GRAIN, [&](const ParallelRange& range) {
+        std::vector<float> row_y(width);
+        float min_val = std::numeric_limits<float>::infinity();
+        for (int y = static_cast<int>(range.mBegin); y < static_cast<int>(range.mEnd); ++y) {
+            std::fill(row_y.begin(), row_y.end(), static_cast<float>(y));
+            float* row = height_map.Row(y);
+            noise.octaves(row_x.data(), row_y.data(), width, scales, row);
+            for (int x = 0; x < width; ++x) {
+                min_val = std::min(min_val, row[x]);
+            }
+        }
+        chunk_min[range.mChunk] = min_val;
+    });
+    const float noise_min = *std::min_element(chunk_min.begin(), chunk_min.end());
+
+    // Edge falloff terms, in double precision like in the serial path
+    std::vector<double> falloff_x(width), falloff_y(height);
+    for (int x = 0; x < width; ++x) falloff_x[x] = std::sin(x / float(width) * M_PI);
+    for (int y = 0; y < height; ++y) falloff_y[y] = std::sin(y / float(height) * M_PI);
+
+    // Apply edge falloff, reducing the range for the final normalization
+    ParallelFor(height, ROW_GRAIN, [&](const ParallelRange& range) {
+        float min_val = std::numeric_limits<float>::infinity();
+        float max_val = -std::numeric_limits<float>::infinity();
+        for (int y = static_cast<int>(range.mBegin); y < static_cast<int>(range.mEnd); ++y) {
+            for (int x = 0; x < width; ++x) {
+                height_map(x, y) -= noise_min;
+                float interpolation = falloff_x[x] + falloff_y[y];
+                height_map(x, y) *= interpolation * interpolation;
+                min_val = std::min(min_val, height_map(x, y));
+                max_val = std::max(max_val, height_map(x, y));
+            }
+        }
+        chunk_min[range.mChunk] = min_val;
+        chunk_max[range.mChunk] = max_val;
+    });
+    const float min_val = *std::min_element(chunk_min.begin(), chunk_min.end());
+    const float max_val = *std::max_element(chunk_max.begin(), chunk_max.end());
+
+    // Final normalization
+    ParallelFor(height, ROW_GRAIN, [&](const ParallelRange& range) {
+        for (int y = static_cast<int>(range.mBegin); y < static_cast<int>(range.mEnd); ++y) {
+            for (int x = 0; x < width; ++x) {
+                height_map(x, y) = (height_map(x, y) - min_val) / (max_val - min_val);
+            }
+        }
+    });
+}
+
 TerrainType height_to_terrain(float height) {
     if (height <= WATER_THRESHOLD) return Sea;
     if (height <= WETLANDS_THRESHOLD) return Wetlands;
@@ -184,36 +361,36 @@ TerrainType height_to_terrain(float height) {
     return Mountains;
 }
 
-void label_terrain(const std::vector<std::vector<float>>& height_map,
-                  std::vector<std::vector<TerrainType>>& terrain_map) {
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            terrain_map[x][y] = height_to_terrain(height_map[x][y]);
+void label_terrain(const Grid2D<float>& height_map, Grid2D<TerrainType>& terrain_map) {
+    terrain_map.Resize(height_map.Width(), height_map.Height());
+    for (int y = 0; y < height_map.Height(); ++y) {
+        for (int x = 0; x < height_map.Width(); ++x) {
+            terrain_map(x, y) = height_to_terrain(height_map(x, y));
         }
     }
 }
 
-int flood_fill(const std::vector<std::vector<TerrainType>>& terrain_map,
-               std::vector<std::vector<int>>& labels, int start_x, int start_y, int label) {
-    std::queue<std::pair<int, int>> q;
-    q.push({start_x, start_y});
-    labels[start_x][start_y] = label;
+// queue is only scratch storage, consumed in FIFO order
+int flood_fill(const Grid2D<TerrainType>& terrain_map, Grid2D<int>& labels,
+               std::vector<std::pair<int, int>>& queue, int start_x, int start_y, int label) {
+    queue.clear();
+    queue.push_back({start_x, start_y});
+    labels(start_x, start_y) = label;
     int size = 0;
 
     const std::array<std::pair<int, int>, 4> directions = {{{0, 1}, {0, -1}, {1, 0}, {-1, 0}}};
 
-    while (!q.empty()) {
-        auto [x, y] = q.front();
-        q.pop();
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto [x, y] = queue[head];
         size++;
 
         for (auto [dx, dy] : directions) {
             int nx = x + dx;
             int ny = y + dy;
-            if (nx >= 0 && nx < MAP_WIDTH && ny >= 0 && ny < MAP_HEIGHT &&
-                terrain_map[nx][ny] != Sea && labels[nx][ny] == 0) {
-                labels[nx][ny] = label;
-                q.push({nx, ny});
+            if (terrain_map.Contains(nx, ny) &&
+                terrain_map(nx, ny) != Sea && labels(nx, ny) == 0) {
+                labels(nx, ny) = label;
+                queue.push_back({nx, ny});
             }
         }
     }
@@ -221,16 +398,18 @@ int flood_fill(const std::vector<std::vector<TerrainType>>& terrain_map,
     return size;
 }
 
-void keep_largest_landmass(std::vector<std::vector<TerrainType>>& terrain_map) {
-    std::vector<std::vector<int>> labels(MAP_WIDTH, std::vector<int>(MAP_HEIGHT, 0));
+void keep_largest_landmass(Grid2D<TerrainType>& terrain_map, Grid2D<int>& labels,
+                           std::vector<std::pair<int, int>>& queue) {
+    const int width = terrain_map.Width(), height = terrain_map.Height();
+    labels.Resize(width, height, 0);
     int current_label = 1;
     std::vector<int> label_sizes;
 
     // Flood fill to label connected landmasses
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (terrain_map[x][y] != Sea && labels[x][y] == 0) {
-                int size = flood_fill(terrain_map, labels, x, y, current_label);
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            if (terrain_map(x, y) != Sea && labels(x, y) == 0) {
+                int size = flood_fill(terrain_map, labels, queue, x, y, current_label);
                 label_sizes.push_back(size);
                 current_label++;
             }
@@ -250,44 +429,46 @@ void keep_largest_landmass(std::vector<std::vector<TerrainType>>& terrain_map) {
     }
 
     // Convert everything else to water
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (labels[x][y] != largest_label && labels[x][y] != 0) {
-                terrain_map[x][y] = Sea;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (labels(x, y) != largest_label && labels(x, y) != 0) {
+                terrain_map(x, y) = Sea;
             }
         }
     }
 }
 
-void calculate_distance_from_water(const std::vector<std::vector<TerrainType>>& terrain_map,
-                                  std::vector<std::vector<float>>& distance_map) {
+void calculate_distance_from_water(const Grid2D<TerrainType>& terrain_map, Grid2D<float>& distance_map,
+                                   std::vector<std::pair<int, int>>& queue) {
+    const int width = terrain_map.Width(), height = terrain_map.Height();
+    distance_map.Resize(width, height);
+
     // Initialize distances
-    std::queue<std::pair<int, int>> q;
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (terrain_map[x][y] == Sea) {
-                distance_map[x][y] = 0.0f;
-                q.push({x, y});
+    queue.clear();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (terrain_map(x, y) == Sea) {
+                distance_map(x, y) = 0.0f;
+                queue.push_back({x, y});
             } else {
-                distance_map[x][y] = std::numeric_limits<float>::infinity();
+                distance_map(x, y) = std::numeric_limits<float>::infinity();
             }
         }
     }
 
     // BFS to compute distances
     const std::array<std::pair<int, int>, 4> directions = {{{0, 1}, {0, -1}, {1, 0}, {-1, 0}}};
-    while (!q.empty()) {
-        auto [x, y] = q.front();
-        q.pop();
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto [x, y] = queue[head];
 
         for (auto [dx, dy] : directions) {
             int nx = x + dx;
             int ny = y + dy;
-            if (nx >= 0 && nx < MAP_WIDTH && ny >= 0 && ny < MAP_HEIGHT) {
-                float new_dist = distance_map[x][y] + 1.0f;
-                if (new_dist < distance_map[nx][ny]) {
-                    distance_map[nx][ny] = new_dist;
-                    q.push({nx, ny});
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                float new_dist = distance_map(x, y) + 1.0f;
+                if (new_dist < distance_map(nx, ny)) {
+                    distance_map(nx, ny) = new_dist;
+                    queue.push_back({nx, ny});
                 }
             }
         }
@@ -295,19 +476,19 @@ void calculate_distance_from_water(const std::vector<std::vector<TerrainType>>&
 
     // Normalize distances
     float max_dist = 0.0f;
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (distance_map[x][y] != std::numeric_limits<float>::infinity()) {
-                max_dist = std::max(max_dist, distance_map[x][y]);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (distance_map(x, y) != std::numeric_limits<float>::infinity()) {
+                max_dist = std::max(max_dist, distance_map(x, y));
             }
         }
     }
 
     if (max_dist > 0.0f) {
-        for (int x = 0; x < MAP_WIDTH; ++x) {
-            for (int y = 0; y < MAP_HEIGHT; ++y) {
-                if (distance_map[x][y] != std::numeric_limits<float>::infinity()) {
-                    distance_map[x][y] /= max_dist;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (distance_map(x, y) != std::numeric_limits<float>::infinity()) {
+                    distance_map(x, y) /= max_dist;
                 }
             }
         }
@@ -315,41 +496,55 @@ void calculate_distance_from_water(const std::vector<std::vector<TerrainType>>&
 }
 
 void assign_biomes(uint32_t seed,
-                  const std::vector<std::vector<TerrainType>>& terrain_map,
-                  const std::vector<std::vector<float>>& height_map,
-                  std::vector<std::vector<BiomeType>>& biome_map) {
-    std::vector<std::vector<float>> distance_map(MAP_WIDTH, std::vector<float>(MAP_HEIGHT));
-    calculate_distance_from_water(terrain_map, distance_map);
+                  const Grid2D<TerrainType>& terrain_map,
+                  const Grid2D<float>& height_map,
+                  Grid2D<float>& distance_map,
+                  std::vector<std::pair<int, int>>& queue,
+                  Grid2D<BiomeType>& biome_map) {
+    const int width = terrain_map.Width(), height = terrain_map.Height();
+    calculate_distance_from_water(terrain_map, distance_map, queue);
+    biome_map.Resize(width, height);
 
     PerlinNoise noise(seed + 1000);
 
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (terrain_map[x][y] == Sea) {
-                biome_map[x][y] = Water;
+    // Temperature and dryness noise of a whole column at a time
+    const std::vector<float> temperature_scale = { 20.0f };
+    const std::vector<float> dryness_scale = { 15.0f };
+    std::vector<float> column_x(height), column_y(height);
+    std::vector<float> temperature_noise(height), dryness_noise(height);
+    for (int y = 0; y < height; ++y) column_y[y] = static_cast<float>(y);
+
+    for (int x = 0; x < width; ++x) {
+        std::fill(column_x.begin(), column_x.end(), static_cast<float>(x));
+        noise.octaves(column_x.data(), column_y.data(), height, temperature_scale, temperature_noise.data());
+        noise.octaves(column_x.data(), column_y.data(), height, dryness_scale, dryness_noise.data());
+
+        for (int y = 0; y < height; ++y) {
+            if (terrain_map(x, y) == Sea) {
+                biome_map(x, y) = Water;
                 continue;
             }
 
-            float latitude_factor = float(x) / MAP_WIDTH;
-            float distance_factor = distance_map[x][y];
-            float elevation_factor = height_map[x][y];
+            float latitude_factor = float(x) / width;
+            float distance_factor = distance_map(x, y);
+            float elevation_factor = height_map(x, y);
 
-            float noise_val = noise.noise(x / 20.0f, y / 20.0f);
+            float noise_val = temperature_noise[y];
             float noise_normalized = (noise_val + 1.0f) / 2.0f;
 
             float temperature = latitude_factor - (elevation_factor * ELEVATION_TEMP_REDUCTION) + 
                               (noise_normalized - 0.5f) * TEMPERATURE_NOISE_SCALE;
 
             float coldness_factor = 1.0f - temperature;
-            float noise_val2 = noise.noise(x / 15.0f, y / 15.0f);
+            float noise_val2 = dryness_noise[y];
             float noise_normalized2 = (noise_val2 + 1.0f) / 2.0f;
             float dryness = (distance_factor * 0.5f) + (elevation_factor * 0.3f) + 
                           (coldness_factor * 0.2f) + (noise_normalized2 - 0.5f) * DRYNESS_NOISE_SCALE;
 
             if (temperature > HOT_THRESHOLD) {
-                biome_map[x][y] = (dryness > DRY_THRESHOLD_HOT) ? Drylands : Jungles;
+                biome_map(x, y) = (dryness > DRY_THRESHOLD_HOT) ? Drylands : Jungles;
             } else {
-                biome_map[x][y] = (dryness > DRY_THRESHOLD_COLD) ? Grasslands : Forests;
+                biome_map(x, y) = (dryness > DRY_THRESHOLD_COLD) ? Grasslands : Forests;
             }
         }
     }
@@ -396,10 +591,23 @@ float calculate_travel_cost(TerrainType terrain, BiomeType biome, CultureType cu
     return BASE_TRAVEL_COST + (TERRAIN_BIOME_MISMATCH_PENALTY * mismatch);
 }
 
+// Cost of moving out of or into a province, always a whole number
+float province_movement_cost(TerrainType terrain, BiomeType biome, int roads_level) {
+    return static_cast<float>(30
+        +  15 * (terrain == Plains)
+        +  15 * (terrain == Mountains)
+        +  15 * (roads_level == 0 && (biome == Forests || biome == Jungles))
+        -  5 * roads_level);
+}
+
+// Scan orders feeding the RNG stay column by column, so a seed keeps generating the same map
 void assign_cultures(uint32_t seed,
-                    const std::vector<std::vector<TerrainType>>& terrain_map,
-                    std::vector<std::vector<BiomeType>>& biome_map,
-                    std::vector<std::vector<CultureType>>& culture_map) {
+                    const Grid2D<TerrainType>& terrain_map,
+                    Grid2D<BiomeType>& biome_map,
+                    Grid2D<uint32_t>& cost_map,
+                    BucketQueue& path_queue,
+                    Grid2D<CultureType>& culture_map) {
+    const int width = terrain_map.Width(), height = terrain_map.Height();
     std::mt19937 rng(seed + 2000);
 
     // Culture preferences
@@ -423,10 +631,10 @@ void assign_cultures(uint32_t seed,
         int x_min, x_max, y_min, y_max;
     };
     std::vector<Corner> corners = {
-        {0, MAP_WIDTH/2, 0, MAP_HEIGHT/2},
-        {MAP_WIDTH/2, MAP_WIDTH, 0, MAP_HEIGHT/2},
-        {0, MAP_WIDTH/2, MAP_HEIGHT/2, MAP_HEIGHT},
-        {MAP_WIDTH/2, MAP_WIDTH, MAP_HEIGHT/2, MAP_HEIGHT}
+        {0, width/2, 0, height/2},
+        {width/2, width, 0, height/2},
+        {0, width/2, height/2, height},
+        {width/2, width, height/2, height}
     };
     std::shuffle(corners.begin(), corners.end(), rng);
 
@@ -439,7 +647,7 @@ void assign_cultures(uint32_t seed,
         std::vector<std::pair<int, int>> matching_tiles;
         for (int x = corner.x_min; x < corner.x_max; ++x) {
             for (int y = corner.y_min; y < corner.y_max; ++y) {
-                if (terrain_map[x][y] == pref.terrain && biome_map[x][y] == pref.biome) {
+                if (terrain_map(x, y) == pref.terrain && biome_map(x, y) == pref.biome) {
                     matching_tiles.push_back({x, y});
                 }
             }
@@ -449,7 +657,7 @@ void assign_cultures(uint32_t seed,
         if (matching_tiles.empty()) {
             for (int x = corner.x_min; x < corner.x_max; ++x) {
                 for (int y = corner.y_min; y < corner.y_max; ++y) {
-                    if (terrain_map[x][y] != Sea) {
+                    if (terrain_map(x, y) != Sea) {
                         matching_tiles.push_back({x, y});
                     }
                 }
@@ -463,125 +671,143 @@ void assign_cultures(uint32_t seed,
         }
     }
 
-    // Multi-source Dijkstra
-    std::vector<std::vector<float>> cost_map(MAP_WIDTH, std::vector<float>(MAP_HEIGHT, 
-                                             std::numeric_limits<float>::infinity()));
-    
-    using QueueElement = std::tuple<float, int, int, CultureType>;
-    std::priority_queue<QueueElement, std::vector<QueueElement>, std::greater<>> pq;
+    // Multi-source Dijkstra over the columns, node x * height + y, so equal costs are expanded in the
+    // (x, y) order of the (cost, x, y, culture) heap this replaced. cost_map is indexed (y, x).
+    cost_map.Resize(height, width, NO_PATH);
+    culture_map.Resize(width, height, SteppeNomads);
+    path_queue.Clear();
 
     for (auto [cx, cy, culture] : centers) {
-        cost_map[cx][cy] = 0.0f;
-        culture_map[cx][cy] = culture;
-        pq.push({0.0f, cx, cy, culture});
+        cost_map(cy, cx) = 0;
+        culture_map(cx, cy) = culture;
+        path_queue.Push(0, static_cast<uint32_t>(cx * height + cy));
     }
 
-    const std::array<std::pair<int, int>, 4> directions = {{{0, 1}, {0, -1}, {1, 0}, {-1, 0}}};
+    const auto column_x = [height](uint32_t node) { return static_cast<int>(node / height); };
+    const auto column_y = [height](uint32_t node) { return static_cast<int>(node % height); };
+    ExpandGrid(path_queue, height, width, cost_map.Data(),
+        [&](uint32_t from, uint32_t to) {
+            const int x = column_x(to), y = column_y(to);
+            return StepCost(calculate_travel_cost(terrain_map(x, y), biome_map(x, y),
+                                                  culture_map(column_x(from), column_y(from))));
+        },
+        [&](uint32_t from, uint32_t to) {
+            culture_map(column_x(to), column_y(to)) = culture_map(column_x(from), column_y(from));
+        });
 
-    while (!pq.empty()) {
-        auto [current_cost, x, y, current_culture] = pq.top();
-        pq.pop();
+    // Post-processing: FarmLanders conversion
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            if (culture_map(x, y) == FarmLanders) {
+                if (biome_map(x, y) == Forests || biome_map(x, y) == Jungles) {
+                    if (dist(rng) < 0.5f) {
+                        biome_map(x, y) = Grasslands;
+                    }
+                }
+            }
+        }
+    }
+}
 
-        if (current_cost > cost_map[x][y]) {
-            continue;
+// Creates a province entity for each tile, straight into its final archetype. Land and sea
+// tiles only differ by CultureData, so the whole map is two ecs_bulk_init calls.
+void spawn_tiles(const flecs::world& ecs, flecs::entity tilemap_entity, TileMap& tilemap, const MapGenArena& arena) {
+    const auto& terrain_map = arena.terrain_map;
+    const auto& biome_map = arena.biome_map;
+    const auto& culture_map = arena.culture_map;
+    const auto& height_map = arena.height_map;
+    const int width = terrain_map.Width();
+
+    std::vector<size_t> indices;
+    indices.reserve(terrain_map.Size());
+
+    for (const bool land : {true, false}) {
+        // Row-major order, the same order the tiles were created in one by one
+        indices.clear();
+        for (size_t i = 0; i < terrain_map.Size(); ++i) {
+            if ((terrain_map.Data()[i] != Sea) == land) indices.push_back(i);
         }
+        if (indices.empty()) continue;
 
-        for (auto [dx, dy] : directions) {
-            int nx = x + dx;
-            int ny = y + dy;
+        const size_t count = indices.size();
+        std::vector<ProvinceArmy> armies(count, ProvinceArmy{ .mAmount = 20 });
+        std::vector<Province> provinces(count);
+        std::vector<TileData> tile_data(count);
+        std::vector<CultureData> cultures(land ? count : 0);
 
-            if (nx >= 0 && nx < MAP_WIDTH && ny >= 0 && ny < MAP_HEIGHT) {
-                float travel_cost = calculate_travel_cost(terrain_map[nx][ny], 
-                                                         biome_map[nx][ny], 
-                                                         current_culture);
-                float new_cost = current_cost + travel_cost;
+        for (size_t n = 0; n < count; ++n) {
+            const int x = static_cast<int>(indices[n] % width);
+            const int y = static_cast<int>(indices[n] / width);
 
-                if (new_cost < cost_map[nx][ny]) {
-                    cost_map[nx][ny] = new_cost;
-                    culture_map[nx][ny] = current_culture;
-                    pq.push({new_cost, nx, ny, current_culture});
-                }
-            }
+            auto& province = provinces[n];
+            province.mPosX = x;
+            province.mPosY = y;
+            province.name = "Province_" + std::to_string(x) + "_" + std::to_string(y);
+            province.terrain = terrain_map(x, y);
+            province.biome = biome_map(x, y);
+            province.development = land ? 10 : 0;
+            province.control = land ? 100 : 0;
+
+            province.culture = culture_map(x, y);
+
+            province.movement_cost = province_movement_cost(province.terrain, province.biome, province.roads_level);
+
+            tile_data[n] = { .x = x, .y = y, .height_value = height_map(x, y) };
+            if (land) cultures[n].culture = culture_map(x, y);
+
+            tilemap.army[indices[n]] = armies[n].mAmount;
+            tilemap.SyncProvince(province);
         }
-    }
 
-    // Post-processing: FarmLanders conversion
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            if (culture_map[x][y] == FarmLanders) {
-                if (biome_map[x][y] == Forests || biome_map[x][y] == Jungles) {
-                    if (dist(rng) < 0.5f) {
-                        biome_map[x][y] = Grasslands;
-                    }
-                }
-            }
+        // The component arrays are moved into the ECS storage
+        ecs_bulk_desc_t desc = {};
+        desc.count = static_cast<int32_t>(count);
+        desc.ids[0] = ecs.pair(flecs::ChildOf, tilemap_entity);
+        desc.ids[1] = ecs.id<ProvinceArmy>();
+        desc.ids[2] = ecs.id<Province>();
+        desc.ids[3] = ecs.id<TileData>();
+        if (land) desc.ids[4] = ecs.id<CultureData>();
+        void* data[] = { nullptr, armies.data(), provinces.data(), tile_data.data(), cultures.data() };
+        desc.data = data;
+
+        const ecs_entity_t* entities = ecs_bulk_init(ecs.c_ptr(), &desc);
+        for (size_t n = 0; n < count; ++n) {
+            tilemap.tiles[indices[n]] = ecs.entity(entities[n]);
         }
     }
 }
 
 } // anonymous namespace
 
-static void GenerateMap(const flecs::world &ecs, uint32_t seed) {
+static void GenerateMap(const flecs::world &ecs, uint32_t seed,
+                        int width = DEFAULT_MAP_WIDTH, int height = DEFAULT_MAP_HEIGHT) {
+    void(ecs.component<MapGenArena>().add(flecs::Singleton));
+    auto& arena = ecs.ensure<MapGenArena>();
+
     // Create height map
-    std::vector<std::vector<float>> height_map(MAP_WIDTH, std::vector<float>(MAP_HEIGHT));
-    generate_height_map(seed, height_map);
+    arena.height_map.Resize(width, height);
+    generate_height_map_parallel(seed, arena.height_map);
 
     // Create terrain map
-    std::vector<std::vector<TerrainType>> terrain_map(MAP_WIDTH, std::vector<TerrainType>(MAP_HEIGHT));
-    label_terrain(height_map, terrain_map);
-    keep_largest_landmass(terrain_map);
+    label_terrain(arena.height_map, arena.terrain_map);
+    keep_largest_landmass(arena.terrain_map, arena.labels, arena.queue);
 
     // Create biome map
-    std::vector<std::vector<BiomeType>> biome_map(MAP_WIDTH, std::vector<BiomeType>(MAP_HEIGHT));
-    assign_biomes(seed, terrain_map, height_map, biome_map);
+    assign_biomes(seed, arena.terrain_map, arena.height_map, arena.distance_map, arena.queue, arena.biome_map);
 
     // Create culture map
-    std::vector<std::vector<CultureType>> culture_map(MAP_WIDTH,
-                                                      std::vector<CultureType>(MAP_HEIGHT, SteppeNomads));
-    assign_cultures(seed, terrain_map, biome_map, culture_map);
+    assign_cultures(seed, arena.terrain_map, arena.biome_map, arena.cost_map, arena.path_queue, arena.culture_map);
 
     // Create tilemap entity
     auto tilemap_entity = ecs.entity("TileMap");
     auto& tilemap = tilemap_entity.ensure<TileMap>();
-    tilemap.tiles.resize(MAP_WIDTH, std::vector<flecs::entity>(MAP_HEIGHT));
+    tilemap.Resize(width, height);
 
-    // Create province entities for each tile
-    for (int x = 0; x < MAP_WIDTH; ++x) {
-        for (int y = 0; y < MAP_HEIGHT; ++y) {
-            auto tile = ecs.entity().child_of(tilemap_entity);
-
-            tile.set<ProvinceArmy>({ .mAmount = 20 });
-            auto& province = tile.ensure<Province>();
-            province.mPosX = x;
-            province.mPosY = y;
-            province.name = "Province_" + std::to_string(x) + "_" + std::to_string(y);
-            province.terrain = terrain_map[x][y];
-            province.biome = biome_map[x][y];
-            province.development = (terrain_map[x][y] != Sea) ? 10 : 0;
-            province.control = (terrain_map[x][y] != Sea) ? 100 : 0;
-
-            province.culture = culture_map[x][y];
-
-            province.movement_cost = 30
-                +  15 * (province.terrain == Plains)
-                +  15 * (province.terrain == Mountains)
-                +  15 * (province.roads_level == 0 && (province.biome == Forests || province.biome == Jungles))
-                -  5 * province.roads_level;
-
-            auto& tile_data = tile.ensure<TileData>();
-            tile_data.x = x;
-            tile_data.y = y;
-            tile_data.height_value = height_map[x][y];
-
-            if (terrain_map[x][y] != Sea) {
-                auto& culture_data = tile.ensure<CultureData>();
-                culture_data.culture = culture_map[x][y];
-            }
-
-            tilemap.tiles[x][y] = tile;
-        }
-    }
+    const auto spawn_start = std::chrono::steady_clock::now();
+    spawn_tiles(ecs, tilemap_entity, tilemap, arena);
+    arena.spawn_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawn_start).count();
 
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Map Generated Successfully");
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Map %dx%d Generated Successfully", width, height);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Map generator arena: %zu KiB", arena.Bytes() / 1024);
 }
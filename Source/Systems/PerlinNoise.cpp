@@ -0,0 +1,214 @@
+#include "PerlinNoise.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PERLIN_SSE2 1
+#endif
+
+// Gradients of the hash, (0, 1), (0, -1), (1, 0) and (-1, 0)
+constexpr float GRADIENT_X[4] = { 0.0f, 0.0f, 1.0f, -1.0f };
+constexpr float GRADIENT_Y[4] = { 1.0f, -1.0f, 0.0f, 0.0f };
+
+#ifdef PERLIN_AVX2
+// Defined in PerlinNoiseAVX2.cpp, returns how many points were summed (a multiple of 8)
+size_t PerlinOctavesAVX2(const int* permutation, const float* xs, const float* ys, size_t count,
+                         const float* scales, size_t scale_count, float* out);
+#endif
+
+namespace {
+
+float fade(float t) {
+    return 6.0f * t * t * t * t * t - 15.0f * t * t * t * t + 10.0f * t * t * t;
+}
+
+float lerp(float t, float a, float b) {
+    return a + t * (b - a);
+}
+
+float gradient(int hash, float x, float y) {
+    return GRADIENT_X[hash & 3] * x + GRADIENT_Y[hash & 3] * y;
+}
+
+enum class Kernel { Scalar, SSE2, AVX2 };
+
+Kernel select_kernel() {
+#if defined(PERLIN_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2")) return Kernel::AVX2;
+#endif
+#ifdef PERLIN_SSE2
+    return Kernel::SSE2;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+// Chosen on first use, after the CPU detection ran
+Kernel active_kernel() {
+    static const Kernel kernel = select_kernel();
+    return kernel;
+}
+
+#ifdef PERLIN_SSE2
+// Every operation mirrors the scalar code in the same order and without FMA, so the
+// lanes round exactly like noise() does
+
+__m128 fade4(__m128 t) {
+    const __m128 a = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(6.0f), t), t), t), t), t);
+    const __m128 b = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(15.0f), t), t), t), t);
+    const __m128 c = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(10.0f), t), t), t);
+    return _mm_add_ps(_mm_sub_ps(a, b), c);
+}
+
+__m128 lerp4(__m128 t, __m128 a, __m128 b) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+// std::floor for |x| < 2^31, including the sign of -0
+__m128 floor4(__m128 x) {
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    const __m128 floored = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f)));
+    return _mm_or_ps(floored, _mm_and_ps(x, _mm_set1_ps(-0.0f)));
+}
+
+__m128 gradient4(const int (&hash)[4], __m128 x, __m128 y) {
+    const __m128 gx = _mm_setr_ps(GRADIENT_X[hash[0] & 3], GRADIENT_X[hash[1] & 3],
+                                  GRADIENT_X[hash[2] & 3], GRADIENT_X[hash[3] & 3]);
+    const __m128 gy = _mm_setr_ps(GRADIENT_Y[hash[0] & 3], GRADIENT_Y[hash[1] & 3],
+                                  GRADIENT_Y[hash[2] & 3], GRADIENT_Y[hash[3] & 3]);
+    return _mm_add_ps(_mm_mul_ps(gx, x), _mm_mul_ps(gy, y));
+}
+
+__m128 noise4(const int* p, __m128 x, __m128 y) {
+    const __m128 fx = floor4(x);
+    const __m128 fy = floor4(y);
+    alignas(16) int xi[4], yi[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(xi), _mm_and_si128(_mm_cvttps_epi32(fx), _mm_set1_epi32(255)));
+    _mm_store_si128(reinterpret_cast<__m128i*>(yi), _mm_and_si128(_mm_cvttps_epi32(fy), _mm_set1_epi32(255)));
+    const __m128 xf = _mm_sub_ps(x, fx);
+    const __m128 yf = _mm_sub_ps(y, fy);
+    const __m128 xf1 = _mm_sub_ps(xf, _mm_set1_ps(1.0f));
+    const __m128 yf1 = _mm_sub_ps(yf, _mm_set1_ps(1.0f));
+
+    int h00[4], h01[4], h10[4], h11[4];
+    for (int i = 0; i < 4; ++i) {
+        h00[i] = p[xi[i] + p[yi[i]]];
+        h01[i] = p[xi[i] + p[yi[i] + 1]];
+        h10[i] = p[xi[i] + 1 + p[yi[i]]];
+        h11[i] = p[xi[i] + 1 + p[yi[i] + 1]];
+    }
+
+    const __m128 g00 = gradient4(h00, xf, yf);
+    const __m128 g01 = gradient4(h01, xf, yf1);
+    const __m128 g10 = gradient4(h10, xf1, yf);
+    const __m128 g11 = gradient4(h11, xf1, yf1);
+
+    const __m128 t = fade4(xf);
+    const __m128 u = fade4(yf);
+    return lerp4(u, lerp4(t, g00, g10), lerp4(t, g01, g11));
+}
+
+size_t octaves_sse2(const int* permutation, const float* xs, const float* ys, size_t count,
+                    const std::vector<float>& scales, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(xs + i);
+        const __m128 y = _mm_loadu_ps(ys + i);
+        __m128 value = _mm_setzero_ps();
+        for (const float scale : scales) {
+            const __m128 s = _mm_set1_ps(scale);
+            value = _mm_add_ps(value, noise4(permutation, _mm_div_ps(x, s), _mm_div_ps(y, s)));
+        }
+        _mm_storeu_ps(out + i, value);
+    }
+    return i;
+}
+#endif
+
+} // anonymous namespace
+
+PerlinNoise::PerlinNoise(uint32_t seed) {
+    std::mt19937 rng(seed);
+    for (int i = 0; i < 256; ++i) {
+        permutation[i] = i;
+    }
+    std::shuffle(permutation.begin(), permutation.begin() + 256, rng);
+    for (int i = 0; i < 256; ++i) {
+        permutation[256 + i] = permutation[i];
+    }
+}
+
+float PerlinNoise::noise(float x, float y) const {
+    int xi = static_cast<int>(std::floor(x)) & 255;
+    int yi = static_cast<int>(std::floor(y)) & 255;
+    float xf = x - std::floor(x);
+    float yf = y - std::floor(y);
+
+    float g00 = gradient(permutation[xi + permutation[yi]], xf, yf);
+    float g01 = gradient(permutation[xi + permutation[yi + 1]], xf, yf - 1.0f);
+    float g10 = gradient(permutation[xi + 1 + permutation[yi]], xf - 1.0f, yf);
+    float g11 = gradient(permutation[xi + 1 + permutation[yi + 1]], xf - 1.0f, yf - 1.0f);
+
+    float t = fade(xf);
+    float u = fade(yf);
+    return lerp(u, lerp(t, g00, g10), lerp(t, g01, g11));
+}
+
+void PerlinNoise::octaves(const float* xs, const float* ys, size_t count,
+                          const std::vector<float>& scales, float* out) const {
+    const Kernel kernel = active_kernel();
+    size_t done = 0;
+#ifdef PERLIN_AVX2
+    if (kernel == Kernel::AVX2)
+        done = PerlinOctavesAVX2(permutation.data(), xs, ys, count, scales.data(), scales.size(), out);
+#endif
+#ifdef PERLIN_SSE2
+    if (kernel != Kernel::Scalar)
+        done += octaves_sse2(permutation.data(), xs + done, ys + done, count - done, scales, out + done);
+#endif
+    octaves_scalar(xs + done, ys + done, count - done, scales, out + done);
+}
+
+void PerlinNoise::octaves_scalar(const float* xs, const float* ys, size_t count,
+                                 const std::vector<float>& scales, float* out) const {
+    for (size_t i = 0; i < count; ++i) {
+        float value = 0.0f;
+        for (const float scale : scales) {
+            value += noise(xs[i] / scale, ys[i] / scale);
+        }
+        out[i] = value;
+    }
+}
+
+float PerlinNoise::noise_legacy(float x, float y) const {
+    const auto gradient = [](int hash, float gx, float gy) {
+        const std::array<std::array<float, 2>, 4> vectors = {{ {0, 1}, {0, -1}, {1, 0}, {-1, 0} }};
+        const auto& g = vectors[hash % 4];
+        return g[0] * gx + g[1] * gy;
+    };
+
+    int xi = static_cast<int>(std::floor(x)) & 255;
+    int yi = static_cast<int>(std::floor(y)) & 255;
+    float xf = x - std::floor(x);
+    float yf = y - std::floor(y);
+
+    float g00 = gradient(permutation[xi + permutation[yi]], xf, yf);
+    float g01 = gradient(permutation[xi + permutation[yi + 1]], xf, yf - 1.0f);
+    float g10 = gradient(permutation[xi + 1 + permutation[yi]], xf - 1.0f, yf);
+    float g11 = gradient(permutation[xi + 1 + permutation[yi + 1]], xf - 1.0f, yf - 1.0f);
+
+    float t = fade(xf);
+    float u = fade(yf);
+    return lerp(u, lerp(t, g00, g10), lerp(t, g01, g11));
+}
+
+const char* PerlinNoise::kernel_name() {
+    switch (active_kernel()) {
+        case Kernel::AVX2: return "AVX2";
+        case Kernel::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int PERLIN_TABLE_SIZE = 512;
+
+class PerlinNoise {
+public:
+    explicit PerlinNoise(uint32_t seed);
+
+    // Noise at a single point
+    float noise(float x, float y) const;
+
+    // Sums noise(xs[i] / scale, ys[i] / scale) over all scales, in order, for count points.
+    // Vectorised when the CPU allows, the result is bit-identical to the scalar sum.
+    void octaves(const float* xs, const float* ys, size_t count,
+                 const std::vector<float>& scales, float* out) const;
+
+    // Same as octaves(), always through noise(), for reference and benchmarks
+    void octaves_scalar(const float* xs, const float* ys, size_t count,
+                        const std::vector<float>& scales, float* out) const;
+
+    // noise() as it was before the gradient tables and kernels, only kept as the --bench-noise baseline
+    float noise_legacy(float x, float y) const;
+
+    // Name of the kernel used by octaves()
+    static const char* kernel_name();
+
+private:
+    std::array<int, PERLIN_TABLE_SIZE> permutation;
+};
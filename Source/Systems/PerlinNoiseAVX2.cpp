@@ -0,0 +1,79 @@
+// Compiled with AVX2 enabled only when PERLIN_AVX2 is set, see CMakeLists.txt
+#if defined(PERLIN_AVX2) && defined(__AVX2__)
+
+#include <cstddef>
+#include <immintrin.h>
+
+namespace {
+
+// Mirrors the scalar noise() operation by operation, without FMA, see PerlinNoise.cpp
+
+__m256 fade8(__m256 t) {
+    const __m256 a = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(6.0f), t), t), t), t), t);
+    const __m256 b = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(15.0f), t), t), t), t);
+    const __m256 c = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(10.0f), t), t), t);
+    return _mm256_add_ps(_mm256_sub_ps(a, b), c);
+}
+
+__m256 lerp8(__m256 t, __m256 a, __m256 b) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+// Gradients (0, 1), (0, -1), (1, 0) and (-1, 0), selected by the two low bits of the hash
+__m256 gradient8(__m256i hash, __m256 x, __m256 y) {
+    const __m256i index = _mm256_and_si256(hash, _mm256_set1_epi32(3));
+    const __m256 gx = _mm256_permutevar8x32_ps(_mm256_setr_ps(0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, -1.0f), index);
+    const __m256 gy = _mm256_permutevar8x32_ps(_mm256_setr_ps(1.0f, -1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 0.0f), index);
+    return _mm256_add_ps(_mm256_mul_ps(gx, x), _mm256_mul_ps(gy, y));
+}
+
+__m256i lookup8(const int* p, __m256i index) {
+    return _mm256_i32gather_epi32(p, index, 4);
+}
+
+__m256 noise8(const int* p, __m256 x, __m256 y) {
+    // floor keeps the sign of -0 just like std::floor
+    const __m256 fx = _mm256_floor_ps(x);
+    const __m256 fy = _mm256_floor_ps(y);
+    const __m256i mask = _mm256_set1_epi32(255);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i xi = _mm256_and_si256(_mm256_cvttps_epi32(fx), mask);
+    const __m256i yi = _mm256_and_si256(_mm256_cvttps_epi32(fy), mask);
+    const __m256 xf = _mm256_sub_ps(x, fx);
+    const __m256 yf = _mm256_sub_ps(y, fy);
+    const __m256 xf1 = _mm256_sub_ps(xf, _mm256_set1_ps(1.0f));
+    const __m256 yf1 = _mm256_sub_ps(yf, _mm256_set1_ps(1.0f));
+
+    const __m256i py0 = lookup8(p, yi);
+    const __m256i py1 = lookup8(p, _mm256_add_epi32(yi, one));
+    const __m256i xi1 = _mm256_add_epi32(xi, one);
+
+    const __m256 g00 = gradient8(lookup8(p, _mm256_add_epi32(xi, py0)), xf, yf);
+    const __m256 g01 = gradient8(lookup8(p, _mm256_add_epi32(xi, py1)), xf, yf1);
+    const __m256 g10 = gradient8(lookup8(p, _mm256_add_epi32(xi1, py0)), xf1, yf);
+    const __m256 g11 = gradient8(lookup8(p, _mm256_add_epi32(xi1, py1)), xf1, yf1);
+
+    const __m256 t = fade8(xf);
+    const __m256 u = fade8(yf);
+    return lerp8(u, lerp8(t, g00, g10), lerp8(t, g01, g11));
+}
+
+} // anonymous namespace
+
+size_t PerlinOctavesAVX2(const int* permutation, const float* xs, const float* ys, size_t count,
+                         const float* scales, size_t scale_count, float* out) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(xs + i);
+        const __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 value = _mm256_setzero_ps();
+        for (size_t s = 0; s < scale_count; ++s) {
+            const __m256 scale = _mm256_set1_ps(scales[s]);
+            value = _mm256_add_ps(value, noise8(permutation, _mm256_div_ps(x, scale), _mm256_div_ps(y, scale)));
+        }
+        _mm256_storeu_ps(out + i, value);
+    }
+    return i;
+}
+
+#endif
@@ -1,15 +1,16 @@
 #include "ProvinceUpdate.hpp"
 
-#include <queue>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
 
 #include "Characters.hpp"
+#include "Diplomacy.hpp"
 #include "GameTime.hpp"
 #include "Components/Province.hpp"
 #include "EstatePower.hpp"
 #include "MapGenerator.hpp"
+#include "Queries.hpp"
 #include "Random.hpp"
 
 const int ESTATE_EFFECT_THRESHOLD = 75;
@@ -23,12 +24,10 @@ struct EntityHash {
 
 void GatherProvinceRevenue(const flecs::world& ecs, const GameTickSources &timers)
 {
-    auto qProvinceRuler = ecs.query_builder<Character>("qProvinceRuler")
-        .with<RuledBy>("$this").src("$title")
-        .with<InRealm>("$title").src("$province")
-        .build();
+    const auto qProvinceRuler = ecs.get<QueryRegistry>().qProvinceRuler;
 
     ecs.system<Province, const GameTime>()
+        .kind<SimulationStep>()
         .tick_source(timers.mYearTimer)
         .each([=](flecs::iter &it, size_t i, Province &province, const GameTime &gameTime)
         {
@@ -53,108 +52,87 @@ void GatherProvinceRevenue(const flecs::world& ecs, const GameTickSources &timer
         });
 }
 
-void UpdateDistanceToCapital(const flecs::world& ecs, const GameTickSources &timers) {
-    // Iterate over the TileMap to access the grid structure and global dimensions
-    ecs.system<const TileMap>("ReCalculateDistancesToCapital")
-        .kind(flecs::PreUpdate)
-        .tick_source(timers.mMonthTimer)
-        .each([&](flecs::iter& it, size_t, const TileMap &tileMap) {
-
-            auto world = it.world();
+void CapitalDistanceField::Solve(const TileMap &tileMap) {
+    const size_t count = tileMap.tiles.size();
+    distance.assign(count, NO_PATH);
+    source.assign(count, 0);
+    queue.Clear();
+
+    for (const auto &[tile, realm] : capitals) {
+        if (tileMap.realm[tile] == realm) {
+            distance[tile] = 0;
+            source[tile] = realm;
+            queue.Push(0, tile);
+            continue;
+        }
+
+        // The capital was taken by another realm, its own realm's search still starts there
+        // but the tile is left to the search of its owner
+        const int x = static_cast<int>(tile % static_cast<uint32_t>(tileMap.width));
+        const int y = static_cast<int>(tile / static_cast<uint32_t>(tileMap.width));
+        const std::pair<int, int> neighbours[] = {{x, y + 1}, {x, y - 1}, {x + 1, y}, {x - 1, y}};
+        for (const auto &[nx, ny] : neighbours) {
+            if (!tileMap.Contains(nx, ny)) continue;
+
+            const auto next = static_cast<uint32_t>(tileMap.Index(nx, ny));
+            const uint32_t cost = StepCost(tileMap.movement_cost[next]);
+            if (tileMap.realm[next] != realm || cost == NO_PATH || cost >= distance[next]) continue;
+
+            distance[next] = cost;
+            source[next] = realm;
+            queue.Push(cost, next);
+        }
+    }
 
-            // 1. Query all entities that are Capitals.
-            // We need 'TileData' to get the starting (x, y) coordinates.
-            auto qCapitals = world.query_builder<const Province, const TileData>()
-                .with<CapitalOf>(flecs::Wildcard)
-                .build();
+    ExpandGrid(queue, tileMap.width, tileMap.height, distance.data(),
+        [&](uint32_t from, uint32_t to) {
+            // The neighbor must belong to the same realm as the capital that reached this tile,
+            // entering it costs its movement cost
+            if (tileMap.realm[to] != source[from]) return NO_PATH;
+            return StepCost(tileMap.movement_cost[to]);
+        },
+        [&](uint32_t from, uint32_t to) { source[to] = source[from]; });
+}
 
-            // 2. Process each capital individually
-            qCapitals.each([&](flecs::entity capitalEntity, const Province&, const TileData& capTile) {
+void UpdateDistanceToCapital(const flecs::world& ecs, const GameTickSources &timers) {
+    // All entities that are Capitals, 'TileData' has the starting (x, y) coordinates
+    const auto &queries = ecs.get<QueryRegistry>();
+    const auto qCapitals = queries.qCapitals;
+    const auto qProvinces = queries.qProvinces;
 
-                // Identify the specific Title (Realm) this province belongs to
-                flecs::entity realmTitle = capitalEntity.target<CapitalOf>();
+    void(ecs.component<CapitalDistanceField>().add(flecs::Singleton));
+    void(ecs.add<CapitalDistanceField>());
 
+    ecs.system<const TileMap, CapitalDistanceField>("ReCalculateDistancesToCapital")
+        .kind<SimulationStep>()
+        .tick_source(timers.mMonthTimer)
+        .each([qCapitals, qProvinces](const TileMap &tileMap, CapitalDistanceField &field) {
+            auto &capitals = field.capitals;
+            capitals.clear();
+            qCapitals.each([&](flecs::entity capitalEntity, const Province&, const TileData& capTile) {
+                // The specific Title (Realm) this province is the capital of
+                const flecs::entity realmTitle = capitalEntity.target<CapitalOf>();
                 if (!realmTitle.is_valid()) return;
+                capitals.emplace_back(static_cast<uint32_t>(tileMap.Index(capTile.x, capTile.y)), realmTitle.id());
+            });
 
-                // --- Dijkstra Algorithm Initialization ---
-
-                int width = tileMap.width;
-                int height = tileMap.height;
-
-                // Priority Queue: <Distance, X, Y> (Min-Heap)
-                using Node = std::tuple<float, int, int>;
-                std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
-
-                // Local distance buffer to track shortest paths during this flood fill
-                // Initialized to infinity
-                std::vector<std::vector<float>> minDist(
-                    width,
-                    std::vector<float>(height, std::numeric_limits<float>::infinity())
-                );
-
-                // Start at the Capital
-                minDist[capTile.x][capTile.y] = 0.0f;
-                pq.push({0.0f, capTile.x, capTile.y});
-
-                // Update the capital's own distance immediately
-                auto capital = capitalEntity.ensure<Province>();
-                capital.distance_to_capital = 0.f;
-
-                // Cardinal directions (N, S, E, W)
-                const int dx[] = {0, 0, 1, -1};
-                const int dy[] = {1, -1, 0, 0};
-
-                // --- Expansion Loop ---
-
-                while (!pq.empty()) {
-                    auto [currentDist, cx, cy] = pq.top();
-                    pq.pop();
-
-                    // Optimization: If we found a shorter path to this node already, skip
-                    if (currentDist > minDist[cx][cy]) continue;
-
-                    // Check all 4 neighbors
-                    for (int i = 0; i < 4; ++i) {
-                        int nx = cx + dx[i];
-                        int ny = cy + dy[i];
-
-                        // Bounds check
-                        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
-
-                        flecs::entity neighborEntity = tileMap.tiles[nx][ny];
-                        if (!neighborEntity.is_valid()) continue;
-
-                        // Constraint 1: The neighbor must belong to the SAME Realm (Title)
-                        if (!neighborEntity.has<InRealm>(realmTitle)) continue;
-
-                        // Constraint 2: Retrieve neighbor data for movement cost calculation
-                        Province neighborProv = neighborEntity.ensure<Province>();
-
-                        // Calculate new distance (using the neighbor's movement cost to enter)
-                        float newDist = currentDist + neighborProv.movement_cost;
-
-                        if (newDist < minDist[nx][ny]) {
-                            minDist[nx][ny] = newDist;
-                            pq.push({newDist, nx, ny});
+            field.Solve(tileMap);
 
-                            // Apply the calculated distance to the component
-                            neighborProv.distance_to_capital = newDist;
-                        }
-                    }
-                }
+            // Write back in table order, tiles no capital reaches keep their last distance
+            qProvinces.each([&](Province &province) {
+                const uint32_t distance = field.distance[tileMap.Index(static_cast<int>(province.mPosX),
+                                                                       static_cast<int>(province.mPosY))];
+                if (distance != NO_PATH)
+                    province.distance_to_capital = static_cast<float>(distance);
             });
         });
 }
 
 void UpdateStats(const flecs::world& ecs, const GameTickSources &timers) {
-    auto qPlayerProvinces = ecs.query_builder<Province>()
-        .with<InRealm>("$title")
-        .with<RulerOf>("$title").src("$player")
-        .with<Player>().src("$player")
-        .build();
+    const auto qPlayerProvinces = ecs.get<QueryRegistry>().qPlayerProvinces;
 
     ecs.system("EstateEffects")
-        .kind(flecs::PreUpdate)
+        .kind<SimulationStep>()
         .tick_source(timers.mWeekTimer)
         .run([=](flecs::iter& it) {
             const auto estates = it.world().get<EstatePowers>();
@@ -196,9 +174,11 @@ void UpdateStats(const flecs::world& ecs, const GameTickSources &timers) {
             auto rulerCulture = player.get<CharacterCulture>().culture;
             auto rulerTraits = GetCulturalTraits(rulerCulture);
 
+            const uint64_t day = it.world().get<GameTime>().TimeDays();
             qPlayerProvinces.each([&](flecs::entity t, Province& p) {
 
-                if (Random::GetIntRange(0,100) <= chance+5)
+                RandomStream rng(RandomSubsystem::Provinces, t.id(), day);
+                if (rng.GetIntRange(0,100) <= chance+5)
                     p.development =
                         std::clamp<unsigned int>(
                             change + p.development
@@ -231,14 +211,124 @@ void UpdateStats(const flecs::world& ecs, const GameTickSources &timers) {
                     +  10 * (p.terrain == Mountains)
                     +  10 * (p.roads_level == 0 && (p.biome == Forests || p.biome == Jungles))
                     -  5 * p.roads_level;
+
+                if (auto *tileMap = t.parent().try_get_mut<TileMap>())
+                    tileMap->SyncProvince(p);
             });
         });
 }
 
+// Last title up the InRealm chain of a realm, the realm itself if it has no liege
+flecs::entity_t TopmostRealm(const flecs::world& ecs, flecs::entity_t realm) {
+    while (realm && ecs.is_alive(realm)) {
+        const flecs::entity liege = ecs.entity(realm).target<InRealm>();
+        if (!liege) break;
+        realm = liege;
+    }
+    return realm;
+}
+
+// Moves a tile to another topmost realm, keeping the Neighboring pairs in step with the shared borders
+void SetTileTopmost(const flecs::world& world, TileMap& tileMap, size_t index, flecs::entity_t top) {
+    tileMap.SetTopmost(index, top, [&](flecs::entity_t a, flecs::entity_t b, bool neighbouring) {
+        // Neighboring is symmetric, one side is enough
+        if (neighbouring) void(flecs::entity(world, a).add<Neighboring>(flecs::entity(world, b)));
+        else void(flecs::entity(world, a).remove<Neighboring>(flecs::entity(world, b)));
+    });
+}
+
+// Moves the tiles of a title and of all its vassals to another topmost realm. Walks the (InRealm, title)
+// pairs down the vassal tree, so the cost follows the size of the realm rather than of the map.
+void SetSubtreeTopmost(const flecs::world& world, flecs::entity_t title, flecs::entity_t top) {
+    world.each(world.pair<InRealm>(title), [&](flecs::entity e) {
+        if (e.has<Title>()) {
+            SetSubtreeTopmost(world, e.id(), top);
+            return;
+        }
+        const auto *province = e.try_get<Province>();
+        auto *tileMap = e.parent().try_get_mut<TileMap>();
+        if (!province || !tileMap) return;
+        SetTileTopmost(world, *tileMap,
+                       tileMap->Index(static_cast<int>(province->mPosX), static_cast<int>(province->mPosY)), top);
+    });
+}
+
+void SyncTileMapColumns(const flecs::world& ecs) {
+    // Outside the module scope, the columns must follow the ECS even while the module is disabled
+    const auto oldScope = ecs.set_scope(flecs::entity::null());
+
+    // Direct realm of each tile, InRealm is exclusive so a change is a remove followed by an add
+    ecs.observer<const Province>("SyncTileRealm")
+        .with<InRealm>(flecs::Wildcard)
+        .event(flecs::OnAdd)
+        .event(flecs::OnRemove)
+        .each([](flecs::iter& it, size_t i, const Province& province) {
+            auto *tileMap = it.entity(i).parent().try_get_mut<TileMap>();
+            if (!tileMap) return;
+
+            const flecs::entity_t target = it.pair(1).second();
+            const size_t index = tileMap->Index(static_cast<int>(province.mPosX), static_cast<int>(province.mPosY));
+            auto &realm = tileMap->realm[index];
+            if (it.event() == flecs::OnAdd)
+            {
+                realm = target;
+                SetTileTopmost(it.world(), *tileMap, index, TopmostRealm(it.world(), target));
+            }
+            else if (realm == target)
+            {
+                realm = 0;
+                SetTileTopmost(it.world(), *tileMap, index, 0);
+            }
+            tileMap->MarkDirty(index);
+        });
+
+    // A title changing liege moves every tile below it to another topmost realm
+    ecs.observer<const Title>("SyncTileTopmostRealm")
+        .with<InRealm>(flecs::Wildcard)
+        .event(flecs::OnAdd)
+        .event(flecs::OnRemove)
+        .each([](flecs::iter& it, size_t i, const Title&) {
+            const auto world = it.world();
+            const flecs::entity_t title = it.entity(i).id();
+
+            // OnRemove runs while the pair is still there, afterwards the title tops its own tiles
+            const flecs::entity_t top = it.event() == flecs::OnAdd ? TopmostRealm(world, it.pair(1).second()) : title;
+            SetSubtreeTopmost(world, title, top);
+        });
+
+    ecs.observer<const Province>("SyncTileCapital")
+        .with<CapitalOf>(flecs::Wildcard)
+        .event(flecs::OnAdd)
+        .event(flecs::OnRemove)
+        .each([](flecs::iter& it, size_t i, const Province& province) {
+            auto *tileMap = it.entity(i).parent().try_get_mut<TileMap>();
+            if (!tileMap) return;
+
+            const size_t index = tileMap->Index(static_cast<int>(province.mPosX), static_cast<int>(province.mPosY));
+            tileMap->capital[index] = it.event() == flecs::OnAdd;
+            tileMap->MarkDirty(index);
+        });
+
+    ecs.observer<const ProvinceArmy, const Province>("SyncTileArmy")
+        .term_at(1).filter()
+        .event(flecs::OnSet)
+        .each([](flecs::entity e, const ProvinceArmy& army, const Province& province) {
+            auto *tileMap = e.parent().try_get_mut<TileMap>();
+            if (!tileMap) return;
+
+            const size_t index = tileMap->Index(static_cast<int>(province.mPosX), static_cast<int>(province.mPosY));
+            tileMap->army[index] = army.mAmount;
+            tileMap->MarkDirty(index);
+        });
+
+    void(ecs.set_scope(oldScope));
+}
+
 ProvinceUpdates::ProvinceUpdates(flecs::world &ecs) {
     const auto &timers = ecs.get<GameTickSources>();
 
     GatherProvinceRevenue(ecs, timers);
     UpdateDistanceToCapital(ecs, timers);
     UpdateStats(ecs, timers);
+    SyncTileMapColumns(ecs);
 }
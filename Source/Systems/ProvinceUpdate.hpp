@@ -1,6 +1,27 @@
 #pragma once
 
 #include <flecs.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "GridPaths.hpp"
+
+struct TileMap;
+
+// Distance of every tile to the capital of its realm, walking only through the realm's own tiles.
+// Kept as a singleton so the monthly solve reuses its buffers.
+struct CapitalDistanceField {
+    std::vector<uint32_t> distance;       // Laid out like the TileMap columns, NO_PATH where no capital reaches
+    std::vector<flecs::entity_t> source;  // Realm whose capital reached the tile
+    std::vector<std::pair<uint32_t, flecs::entity_t>> capitals; // (Tile, realm) of every capital, filled before Solve()
+    BucketQueue queue;
+
+    // Single multi-source Dijkstra from every capital, a tile is only entered from
+    // a tile that was reached from its own realm's capital. A capital held by another
+    // realm is reached by its holder, its own realm's search starts from its neighbours.
+    void Solve(const TileMap &tileMap);
+};
 
 struct ProvinceUpdates {
     explicit ProvinceUpdates(flecs::world& ecs);
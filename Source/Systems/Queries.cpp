@@ -0,0 +1,38 @@
+#include "Queries.hpp"
+
+#include <SDL3/SDL.h>
+
+QueryRegistry::QueryRegistry(const flecs::world &ecs)
+: qProvinces(ecs.query_builder<Province>("Provinces")
+    .build())
+, qPlayerRealm(ecs.query_builder<const Title>("PlayerRealm")
+    .with<RulerOf>("$this").src<Player>()
+    .without<InRealm>(flecs::Wildcard)
+    .build())
+, qPlayerProvinces(ecs.query_builder<Province>("PlayerProvinces")
+    .with<InRealm>("$title")
+    .with<RulerOf>("$title").src("$player")
+    .with<Player>().src("$player")
+    .build())
+, qProvinceRuler(ecs.query_builder<Character>("ProvinceRuler")
+    .with<RuledBy>("$this").src("$title")
+    .with<InRealm>("$title").src("$province")
+    .build())
+, qCapitals(ecs.query_builder<const Province, const TileData>("Capitals")
+    .with<CapitalOf>(flecs::Wildcard)
+    .build())
+{
+#ifndef NDEBUG
+    // Named and cached queries are entities with an (EcsPoly, EcsQuery) pair. One created while the
+    // pipeline runs is rebuilt by a system on every tick and belongs in the registry.
+    ecs.observer("WarnAdHocQueries")
+        .with(ecs_pair(ecs_id(EcsPoly), EcsQuery))
+        .event(flecs::OnAdd)
+        .each([](flecs::iter &it, size_t i)
+        {
+            if (!it.world().is_readonly()) return;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Query %s built inside a system, move it to QueryRegistry",
+                        it.entity(i).path().c_str());
+        });
+#endif
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <flecs.h>
+
+#include "Characters.hpp"
+#include "MapGenerator.hpp"
+
+// Queries shared by the systems, built once when the modules are imported.
+// Systems capture the handles by value instead of building queries while they run.
+struct QueryRegistry
+{
+    explicit QueryRegistry(const flecs::world &ecs);
+
+    flecs::query<Province> qProvinces;
+    // Topmost title ruled by the player
+    flecs::query<const Title> qPlayerRealm;
+    // Provinces of the player's realm
+    flecs::query<Province> qPlayerProvinces;
+    // Ruler of the title the province in $province belongs to
+    flecs::query<Character> qProvinceRuler;
+    // Capital provinces, the title is the target of their (CapitalOf, *) pair
+    flecs::query<const Province, const TileData> qCapitals;
+};